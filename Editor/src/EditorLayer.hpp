@@ -17,6 +17,7 @@ namespace Editor
         virtual void OnDraw() override;
         virtual void OnDetach() override;
         virtual void OnEvent(ant::Event *event) override;
+        virtual bool OnSnapshot(ant::RenderPacket &packet) override { return true; } // OnDraw draws nothing yet
 
     private:
         void DockSpace();
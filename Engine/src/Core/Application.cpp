@@ -2,9 +2,15 @@
 #include "Logger.hpp"
 #include <Gl.h>
 #include "Core/Core.hpp"
+#include "Core/JobSystem.hpp"
+#include "Core/Random.hpp"
 #include "Render/RendererCommands.hpp"
+#include "Render/RenderThread.hpp"
+#include "Render/NullGl.hpp"
 #include "Input/Event.hpp"
 #include "debug/ImGuiLayer.hpp"
+#include "debug/Instrumentation.hpp"
+#include "debug/Metrics.hpp"
 
 void test();
 namespace ant
@@ -14,6 +20,7 @@ namespace ant
     Application::~Application()
     {
         //todo shutdown glew
+        JobSystem::Shutdown();
     }
 
     void Application::Init()
@@ -21,15 +28,26 @@ namespace ant
         ant::Logger::Init();
 
         CORE_INFO("Hello!");
+        Random::Init(m_appdata.randomSeed);
 
-        m_window.SetEventCallback(CORE_BIND_EVENT_FN(this, Application::OnEvent));
+        if (m_appdata.captureFrames)
+            Instrumentor::Get()->BeginCapture("ant", m_appdata.captureFrames, m_appdata.captureThreshold);
+
+        //? workers only run jobs, the main thread keeps the gl context
+        JobSystem::Init(m_appdata.jobWorkers);
+
+        m_window.SetEventQueue(&m_events);
 
         m_window.Init({m_appdata.windowSettings.width,
                        m_appdata.windowSettings.height,
                        m_appdata.windowSettings.title,
-                       true, false});
+                       true, false,
+                       m_appdata.windowSettings.backend});
+        CORE_ASSERT(m_window.IsOpen(), "No gl context for the application");
 
-        m_layerStack.PushOverlay(MakeRef<ImGuiLayer>());
+        //? imgui loads gl through glx and needs a window for its input, headless runs go without it
+        if (m_appdata.windowSettings.backend == RenderBackend::Native)
+            m_layerStack.PushOverlay(MakeRef<ImGuiLayer>());
 
         RendererCommands::SetClearColor({1.f,0.f,1.f,1.f});
 
@@ -40,19 +58,86 @@ namespace ant
     {
 
         // test();
-        while (m_appdata.running)
+        if (m_appdata.renderLatency)
+            RunPipelined();
+        else
+        {
+            while (NextFrame())
+            {
+                Instrumentor::Get()->MarkFrame();
+                Metrics::OnFrame();
+                m_layerStack.OnUpdate();
+                RendererCommands::Clear();
+                m_layerStack.OnDraw();
+                m_window.Update();
+                DispatchEvents();
+            }
+        }
+
+        //? the render thread is gone by now, every frame is counted
+        if (NullGl::IsInstalled())
+        {
+            auto stats = NullGl::GetStats();
+            CORE_INFO("Null gl, {0} frames: {1} calls, {2} draw calls, {3} vertices, {4} bytes uploaded, {5} bytes mapped",
+                      m_frame, stats.calls, stats.drawCalls, stats.vertices, stats.bytesUploaded, stats.bytesMapped);
+        }
+    }
+
+    void Application::RunPipelined()
+    {
+        //? update of frame N + 1 overlaps drawing frame N, input shows up renderLatency frames later
+        RenderThread renderThread(m_window, m_appdata.renderLatency);
+        glm::ivec2 viewport = m_window.GetSize();
+
+        while (NextFrame())
         {
+            Instrumentor::Get()->MarkFrame(); //? the update thread frame, the render thread scopes of a frame land in the next one
+            Metrics::OnFrame();
+            auto &packet = renderThread.BeginPacket();
             m_layerStack.OnUpdate();
-            RendererCommands::Clear();
-            m_layerStack.OnDraw();
-            m_window.Update();
+
+            if (viewport != m_window.GetSize())
+            {
+                viewport = m_window.GetSize();
+                packet.Submit([viewport]
+                              { RendererCommands::SetViewport(viewport); });
+            }
+
+            packet.Submit(&RendererCommands::Clear);
+            bool synchronous = m_layerStack.OnSnapshot(packet);
+            packet.Submit([this]
+                          { m_window.SwapBuffers(); });
+            renderThread.SubmitPacket();
+
+            //? layers without a snapshot read their own state while drawing, the next update has to wait for them
+            if (synchronous)
+                renderThread.WaitIdle();
+
+            m_window.PollEvents();
+            DispatchEvents();
         }
     }
 
-    void Application::OnEvent(Event &e)
+    bool Application::NextFrame()
     {
-        CORE_INFO("Event triggered {0}", e.GetStringLog());
+        if (m_appdata.frameLimit && m_frame == m_appdata.frameLimit)
+            m_appdata.running = false;
+
+        if (!m_appdata.running)
+            return false;
+
+        m_frame++;
+        return true;
+    }
 
+    void Application::DispatchEvents()
+    {
+        m_events.Drain([this](Event &e)
+                       { OnEvent(e); });
+    }
+
+    void Application::OnEvent(Event &e)
+    {
         m_layerStack.OnEvent(&e);
 
         EventDispatcher d(e);
@@ -1,6 +1,7 @@
 #pragma once
 #include "Graphics/Window.hpp"
 #include "Layer.hpp"
+#include "Input/EventQueue.hpp"
 namespace ant
 {
     class Event;
@@ -8,12 +9,27 @@ namespace ant
     struct AppSettings
     {
         bool running = true;
+        uint32_t jobWorkers = 0; // 0 picks one per hardware thread besides the main one
+        uint64_t randomSeed = 0; // 0 seeds from std::random_device, anything else replays the same Random sequences
+
+        //? frames the render thread may trail the update, 0 updates and draws on one thread
+        //? above 0 a render thread owns the gl context and draws the packets filled by Layer::OnSnapshot
+        uint32_t renderLatency = 0;
+
+        //? keeps the profile scopes of the last captureFrames frames in memory, 0 disables the capture
+        //? a frame over captureThreshold milliseconds (0 never) writes them to ant_capture_<n>.json, see Instrumentor::BeginCapture
+        uint32_t captureFrames = 0;
+        float captureThreshold = 0.f;
+
+        //? stops Run after this many frames, 0 runs until the window closes, the null backend has no window to close
+        uint32_t frameLimit = 0;
 
         struct //? window properties
         {
             uint32_t width = 1240;
             uint32_t height = 720;
             const char *title = "LearnOpenGL";
+            RenderBackend backend = RenderBackend::Native; // Offscreen and Null run headless, without the ImGuiLayer
         } windowSettings;
     };
 
@@ -29,6 +45,18 @@ namespace ant
         void Terminate() { m_appdata.running = false; }
 
         void OnEvent(Event &e);
+        inline EventQueue &GetEventQueue() { return m_events; } // any thread may push events for the next frame
+
+        void SetJobWorkers(uint32_t workers) { m_appdata.jobWorkers = workers; }   //! before Init
+        void SetRandomSeed(uint64_t seed) { m_appdata.randomSeed = seed; }          //! before Init, 0 picks a random seed
+        void SetCapture(uint32_t frames, float thresholdMilliseconds = 0.f)        //! before Init, see AppSettings::captureFrames
+        {
+            m_appdata.captureFrames = frames;
+            m_appdata.captureThreshold = thresholdMilliseconds;
+        }
+        void SetRenderLatency(uint32_t frames) { m_appdata.renderLatency = frames; } //! before Run
+        void SetRenderBackend(RenderBackend backend) { m_appdata.windowSettings.backend = backend; } //! before Init
+        void SetFrameLimit(uint32_t frames) { m_appdata.frameLimit = frames; }                      //! before Run
 
         const Window &GetWindow() const { return m_window; }
 
@@ -39,9 +67,16 @@ namespace ant
     protected:
         Application() {}
 
+    private:
+        void RunPipelined();
+        void DispatchEvents();
+        bool NextFrame(); // counts the frame against the limit, false once the app stops
+
     private:
         AppSettings m_appdata;
+        uint32_t m_frame = 0;
 
+        EventQueue m_events; // filled by the window callbacks, drained once per frame after polling
         Window m_window;
 
     protected:
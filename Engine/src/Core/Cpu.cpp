@@ -0,0 +1,45 @@
+#include "Pch.h"
+#include "Core/Cpu.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ant
+{
+    namespace
+    {
+        bool QueryAvx2()
+        {
+#if !defined(ANT_X86_SIMD)
+            return false;
+#elif defined(__GNUC__) || defined(__clang__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            __cpuid(info, 1);
+            bool fma = info[2] & (1 << 12);
+            bool osxsave = info[2] & (1 << 27);
+            if (!fma || !osxsave || (_xgetbv(0) & 6) != 6) // os saves ymm registers
+                return false;
+
+            __cpuidex(info, 7, 0);
+            return info[1] & (1 << 5);
+#else
+            return false;
+#endif
+        }
+    } // namespace
+
+    bool CpuHasAvx2()
+    {
+        static const bool avx2 = QueryAvx2();
+        return avx2;
+    }
+
+} // namespace ant
@@ -0,0 +1,20 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ANT_X86_SIMD // sse2 is always there, wider sets need CpuHasAvx2
+#include <immintrin.h>
+#endif
+
+//? compiles one function for avx2 + fma without raising the target of the whole build
+#if defined(__GNUC__) || defined(__clang__)
+#define ANT_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define ANT_TARGET_AVX2
+#endif
+
+namespace ant
+{
+    // avx2 and fma usable (cpu and os), checked once
+    bool CpuHasAvx2();
+
+} // namespace ant
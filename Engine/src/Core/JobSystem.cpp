@@ -0,0 +1,310 @@
+#include "Pch.h"
+#include "Core/JobSystem.hpp"
+#include <bit>
+
+namespace ant
+{
+    std::vector<JobSystem::ThreadData *> JobSystem::s_threads;
+    std::vector<std::thread> JobSystem::s_workers;
+    std::mutex JobSystem::s_sleepMutex;
+    std::condition_variable JobSystem::s_wake;
+    std::atomic<uint32_t> JobSystem::s_sleepers = 0;
+    std::atomic<uint64_t> JobSystem::s_signal = 0;
+    std::atomic<bool> JobSystem::s_stop = false;
+    std::atomic<uint32_t> JobSystem::s_externalMask = 1;
+
+    namespace
+    {
+        constexpr uint32_t s_outsidePool = ~0u;
+        thread_local uint32_t s_threadIndex = s_outsidePool; // 0 for the thread calling Init, then external slots and workers
+        std::atomic<bool> s_warnedOutside = false;
+    }
+
+    //? C11 version of the Chase-Lev deque from "Correct and Efficient Work-Stealing for Weak Memory Models"
+    bool WorkStealingDeque::Push(Job *job)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+
+        if (bottom - top >= capacity)
+            return false;
+
+        m_jobs[bottom & (capacity - 1)].store(job, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release); // publishes the job record to thieves
+        return true;
+    }
+
+    Job *WorkStealingDeque::Pop()
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job *job = m_jobs[bottom & (capacity - 1)].load(std::memory_order_relaxed);
+
+        if (top == bottom)
+        {
+            //? last job, races with thieves for it
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    Job *WorkStealingDeque::Steal()
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr;
+
+        Job *job = m_jobs[top & (capacity - 1)].load(std::memory_order_relaxed);
+
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return job;
+    }
+
+    void JobSystem::Init(uint32_t workers)
+    {
+        CORE_PROFILE_FUNC();
+        CORE_ASSERT(!IsRunning(), "JobSystem already initialized!");
+
+        if (!workers)
+            workers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+        s_stop = false;
+        s_externalMask = 1;
+        s_threads.resize(externalThreads + workers);
+        for (auto &thread : s_threads)
+        {
+            thread = new ThreadData();
+            thread->jobs = std::make_unique<Job[]>(jobRing);
+        }
+
+        s_threadIndex = 0;
+        for (uint32_t i = 0; i < workers; i++)
+            s_workers.emplace_back(&JobSystem::WorkerLoop, externalThreads + i);
+
+        CORE_INFO("JobSystem started {0} workers", workers);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        CORE_PROFILE_FUNC();
+        {
+            std::lock_guard lock(s_sleepMutex);
+            s_stop = true;
+        }
+
+        s_wake.notify_all();
+        for (auto &worker : s_workers)
+            worker.join();
+
+        for (auto thread : s_threads)
+            delete thread;
+
+        s_workers.clear();
+        s_threads.clear();
+        s_threadIndex = s_outsidePool;
+    }
+
+    void JobSystem::RegisterThread()
+    {
+        if (!IsRunning() || s_threadIndex != s_outsidePool)
+            return;
+
+        uint32_t mask = s_externalMask.load(std::memory_order_relaxed);
+        uint32_t slot;
+
+        do
+        {
+            slot = std::countr_one(mask);
+            CORE_ASSERT(slot < externalThreads, "JobSystem has no free slot for another thread!");
+        } while (!s_externalMask.compare_exchange_weak(mask, mask | (1u << slot), std::memory_order_acquire, std::memory_order_relaxed));
+
+        s_threadIndex = slot;
+    }
+
+    void JobSystem::UnregisterThread()
+    {
+        if (!IsRunning() || !s_threadIndex || s_threadIndex >= externalThreads)
+            return;
+
+        //? jobs still queued in the slot get stolen by the workers, their records stay in flight until then
+        s_externalMask.fetch_and(~(1u << s_threadIndex), std::memory_order_release);
+        s_threadIndex = s_outsidePool;
+    }
+
+    JobSystem::ThreadData *JobSystem::CurrentThread()
+    {
+        return s_threadIndex < s_threads.size() ? s_threads[s_threadIndex] : nullptr;
+    }
+
+    Job *JobSystem::AllocateJob()
+    {
+        auto thread = CurrentThread();
+        if (!thread)
+        {
+            if (!s_warnedOutside.exchange(true, std::memory_order_relaxed))
+                CORE_WARN("JobSystem used from a thread outside the pool, its jobs run inline, see JobSystem::RegisterThread");
+            return nullptr;
+        }
+
+        //? records are taken in order, one still in flight means the thread is far ahead of the workers
+        Job &job = thread->jobs[thread->nextJob & (jobRing - 1)];
+        if (job.inFlight.load(std::memory_order_acquire))
+            return nullptr;
+
+        job.inFlight.store(true, std::memory_order_relaxed);
+        thread->nextJob++;
+        return &job;
+    }
+
+    void JobSystem::Submit(Job &job, JobCounter *dependency)
+    {
+        if (dependency)
+        {
+            //? the counter lock orders this against the last dependency job draining the list
+            std::lock_guard lock(dependency->mutex);
+            if (!dependency->IsDone())
+            {
+                dependency->continuations.push_back(&job);
+                return;
+            }
+        }
+
+        Push(job);
+    }
+
+    void JobSystem::Push(Job &job)
+    {
+        auto &thread = *CurrentThread(); // only pool threads get here, Run checked it in AllocateJob
+
+        if (!thread.deque.Push(&job))
+        {
+            Execute(job, thread); // deque full, running it here is the back pressure
+            return;
+        }
+
+        //? seq_cst pairs with the sleeper count in WorkerLoop, either the worker sees the signal or we see the sleeper
+        s_signal.fetch_add(1, std::memory_order_seq_cst);
+        if (s_sleepers.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard lock(s_sleepMutex);
+            s_wake.notify_one();
+        }
+    }
+
+    Job *JobSystem::FindJob(ThreadData &thread)
+    {
+        if (Job *job = thread.deque.Pop())
+            return job;
+
+        uint32_t count = s_threads.size();
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t victim = (thread.victim + i) % count;
+            if (s_threads[victim] == &thread)
+                continue;
+
+            if (Job *job = s_threads[victim]->deque.Steal())
+            {
+                thread.victim = victim; // a busy victim likely has more
+                thread.steals.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::Execute(Job &job, ThreadData &thread)
+    {
+        JobCounter *counter = job.counter;
+        job.invoke(job);
+        job.inFlight.store(false, std::memory_order_release); //! the owner may reuse the record from here on
+        thread.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+
+        if (!counter)
+            return;
+
+        //? decremented under the lock, Wait takes it once more so the counter can't die while we drain it
+        std::vector<Job *> continuations;
+        {
+            std::lock_guard lock(counter->mutex);
+            if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                continuations.swap(counter->continuations);
+        }
+
+        //! the counter may be reused by its owner from here on
+        for (auto continuation : continuations)
+            Push(*continuation);
+    }
+
+    void JobSystem::Wait(JobCounter &counter)
+    {
+        CORE_PROFILE_FUNC();
+
+        auto thread = CurrentThread();
+
+        while (!counter.IsDone())
+        {
+            if (Job *job = thread ? FindJob(*thread) : nullptr)
+                Execute(*job, *thread);
+            else
+                std::this_thread::yield();
+        }
+
+        std::lock_guard lock(counter.mutex); // the job that finished it may still hold the lock
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index)
+    {
+        s_threadIndex = index;
+        auto &thread = *s_threads[index];
+
+        while (!s_stop.load(std::memory_order_relaxed))
+        {
+            uint64_t signal = s_signal.load(std::memory_order_seq_cst);
+
+            if (Job *job = FindJob(thread))
+            {
+                Execute(*job, thread);
+                continue;
+            }
+
+            std::unique_lock lock(s_sleepMutex);
+            s_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            s_wake.wait(lock, [&]
+                        { return s_stop.load(std::memory_order_relaxed) || s_signal.load(std::memory_order_seq_cst) != signal; });
+            s_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    JobSystem::Stats JobSystem::GetStats()
+    {
+        Stats stats;
+        for (auto thread : s_threads)
+        {
+            stats.jobsExecuted += thread->jobsExecuted.load(std::memory_order_relaxed);
+            stats.steals += thread->steals.load(std::memory_order_relaxed);
+        }
+
+        return stats;
+    }
+
+} // namespace ant
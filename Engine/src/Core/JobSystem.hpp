@@ -0,0 +1,202 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ant
+{
+    struct Job;
+
+    //? counts unfinished jobs, JobSystem::Wait on it and JobSystem::Run(..., dependency) to start jobs after it
+    //! reuse only after it was waited for, jobs hold a pointer to it until they finish
+    struct JobCounter
+    {
+        inline bool IsDone() const { return !pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+        std::atomic<uint32_t> pending = 0;
+        std::mutex mutex;
+        std::vector<Job *> continuations; // jobs waiting for pending to reach 0
+    };
+
+    //? one unit of work, the callable is stored inline so running a job never allocates
+    struct Job
+    {
+        static constexpr size_t storageSize = 48;
+
+        void (*invoke)(Job &job) = nullptr; // calls and destroys the stored callable
+        JobCounter *counter = nullptr;
+        std::atomic<bool> inFlight = false; // from AllocateJob until the job returned, the record is reused after that
+        alignas(16) std::byte storage[storageSize];
+    };
+
+    //? lock free single owner deque (Chase-Lev), the owner pushes and pops at the bottom, thieves steal from the top
+    class WorkStealingDeque
+    {
+    public:
+        static constexpr int64_t capacity = 4096;
+
+        bool Push(Job *job); // false when full, owner only
+        Job *Pop();          // owner only
+        Job *Steal();        // any thread
+
+    private:
+        alignas(64) std::atomic<int64_t> m_top = 0;
+        alignas(64) std::atomic<int64_t> m_bottom = 0;
+        std::atomic<Job *> m_jobs[capacity];
+    };
+
+    //? engine wide worker pool shared by the scene, renderer, particle and asset systems
+    //? every thread owns a deque, idle threads steal from the others and sleep once nothing is left
+    //? the main thread is thread 0, it never runs jobs on its own but helps while it Waits
+    //! jobs run on worker threads, they must not touch the gl context
+    class JobSystem
+    {
+    public:
+        struct Stats
+        {
+            uint64_t jobsExecuted = 0;
+            uint64_t steals = 0; // jobs taken from another thread's deque
+        };
+
+        //? workers = 0 picks one per hardware thread besides the main one
+        static void Init(uint32_t workers = 0);
+        static void Shutdown();
+        static inline bool IsRunning() { return !s_threads.empty(); }
+        static inline uint32_t GetThreadCount() { return uint32_t(s_workers.size()) + 1; } // workers + the caller
+
+        //? gives a thread outside the pool (the render thread) its own deque, the main thread has one already
+        //! unregistered threads run their jobs inline and only spin in Wait
+        static void RegisterThread();
+        static void UnregisterThread();
+
+        //? queues fn() on the calling thread's deque, counter is incremented now and decremented once fn returns
+        //? with a dependency the job is only queued once the dependency counter is done
+        //? when all jobRing records of the thread are in flight fn runs inline (after the dependency), that is the back pressure
+        template <class Fn>
+        static void Run(Fn &&fn, JobCounter *counter = nullptr, JobCounter *dependency = nullptr);
+
+        //? runs other jobs until counter is done
+        static void Wait(JobCounter &counter);
+
+        //? calls fn(begin, end) over disjoint slices of [0, count) and returns once every slice is done
+        //? slices are at least minSlice long, a few per thread so stealing can even out uneven slices
+        //? the calling thread takes the first slice, without workers everything runs inline
+        template <class Fn>
+        static void ParallelFor(uint32_t count, uint32_t minSlice, Fn &&fn);
+
+        static Stats GetStats();
+
+    private:
+        static constexpr uint32_t jobRing = WorkStealingDeque::capacity;
+        static constexpr uint32_t externalThreads = 4; // deque slots ahead of the workers, 0 is the main thread
+
+        struct alignas(64) ThreadData
+        {
+            WorkStealingDeque deque;
+            std::unique_ptr<Job[]> jobs; // ring of jobRing records, taken in order while the next one is free
+            uint32_t nextJob = 0;
+            std::atomic<uint64_t> jobsExecuted = 0;
+            std::atomic<uint64_t> steals = 0;
+            uint32_t victim = 0; // where stealing starts next time
+        };
+
+        static Job *AllocateJob(); // nullptr when the next record is in flight or the thread is outside the pool
+        static void Submit(Job &job, JobCounter *dependency);
+        static void Push(Job &job);
+        static Job *FindJob(ThreadData &thread);
+        static void Execute(Job &job, ThreadData &thread);
+        static void WorkerLoop(uint32_t index);
+        static ThreadData *CurrentThread(); // nullptr outside the pool
+
+    private:
+        static std::vector<ThreadData *> s_threads; // external threads, then workers
+        static std::atomic<uint32_t> s_externalMask; // external slots in use
+        static std::vector<std::thread> s_workers;
+        static std::mutex s_sleepMutex;
+        static std::condition_variable s_wake;
+        static std::atomic<uint32_t> s_sleepers;
+        static std::atomic<uint64_t> s_signal; // bumped by every push, sleeping workers wait for it to change
+        static std::atomic<bool> s_stop;
+    };
+
+    template <class Fn>
+    void JobSystem::Run(Fn &&fn, JobCounter *counter, JobCounter *dependency)
+    {
+        using Callable = std::decay_t<Fn>;
+        static_assert(sizeof(Callable) <= Job::storageSize && alignof(Callable) <= 16, "Job callable too big, capture by reference instead");
+
+        if (!IsRunning())
+        {
+            fn(); // without workers the job runs right away, so dependencies are already done
+            return;
+        }
+
+        Job *job = AllocateJob();
+        if (!job)
+        {
+            if (dependency)
+                Wait(*dependency);
+            fn();
+            return;
+        }
+
+        new (job->storage) Callable(std::forward<Fn>(fn));
+        job->invoke = [](Job &job)
+        {
+            auto &callable = *std::launder(reinterpret_cast<Callable *>(job.storage));
+            callable();
+            callable.~Callable();
+        };
+
+        job->counter = counter;
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+        Submit(*job, dependency);
+    }
+
+    template <class Fn>
+    void JobSystem::ParallelFor(uint32_t count, uint32_t minSlice, Fn &&fn)
+    {
+        if (!count)
+            return;
+
+        minSlice = std::max(minSlice, 1u);
+        uint32_t slices = std::min<uint32_t>(4 * GetThreadCount(), (count + minSlice - 1) / minSlice);
+
+        if (slices <= 1 || !IsRunning())
+        {
+            fn(0u, count);
+            return;
+        }
+
+        JobCounter counter;
+        auto sliceBegin = [=](uint32_t slice)
+        { return uint32_t(uint64_t(count) * slice / slices); };
+
+        for (uint32_t slice = 1; slice < slices; slice++)
+        {
+            uint32_t begin = sliceBegin(slice);
+            uint32_t end = sliceBegin(slice + 1);
+            Run([&fn, begin, end]
+                { fn(begin, end); },
+                &counter);
+        }
+
+        fn(0u, sliceBegin(1));
+        Wait(counter);
+    }
+
+} // namespace ant
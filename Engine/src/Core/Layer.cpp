@@ -2,6 +2,7 @@
 #include "Core/Layer.hpp"
 #include "Input/Event.hpp"
 #include "debug/Instrumentation.hpp"
+#include "Render/RenderThread.hpp"
 namespace ant
 {
     LayerStack::~LayerStack()
@@ -38,11 +39,40 @@ namespace ant
         }
     }
 
+    bool LayerStack::OnSnapshot(RenderPacket &packet)
+    {
+        CORE_PROFILE_FUNC();
+        bool synchronous = false;
+
+        //? same order as OnDraw, the packet keeps removed layers alive until the render thread detaches them
+        for (size_t i = size(); i-- > 0;)
+        {
+            Ref<Layer> layer = at(i);
+
+            if (!layer->m_active)
+            {
+                packet.Submit([layer]
+                              { layer->OnDetach(); });
+                erase(begin() + i);
+                continue;
+            }
+
+            if (!layer->OnSnapshot(packet))
+            {
+                packet.Submit([layer]
+                              { layer->OnDraw(); });
+                synchronous = true;
+            }
+        }
+
+        return synchronous;
+    }
+
     void LayerStack::OnEvent(Event *event)
     {
         for (auto &it : *this)
         {
-            if (event->m_handled)
+            if (event->IsHandled())
                 break;
 
             it->OnEvent(event);
@@ -6,6 +6,7 @@ namespace ant
 {
 
     class Event;
+    class RenderPacket;
     class Layer
     {
     public:
@@ -19,6 +20,11 @@ namespace ant
         virtual void OnDetach() = 0;
         virtual void OnEvent(Event *event) = 0;
 
+        //? pipelined mode only, called after OnUpdate instead of OnDraw
+        //? copy what OnDraw would read into commands of the packet, they run later on the render thread
+        //? returning false draws this layer with OnDraw on the render thread while the update thread waits
+        virtual bool OnSnapshot(RenderPacket &packet) { return false; }
+
     protected:
         bool m_active = true;
     };
@@ -42,6 +48,7 @@ namespace ant
 
         void OnUpdate();
         void OnDraw();
+        bool OnSnapshot(RenderPacket &packet); // returns true when a layer has to be drawn synchronously
         void OnEvent(Event *event);
 
         void PushLayer(const Ref<Layer> &layer);
@@ -9,6 +9,9 @@ namespace ant
 
     void Logger::Init()
     {
+        if (s_coreLogger)
+            return; // a second Application in the process (the benchmarks) keeps the loggers
+
         s_coreLogger = spdlog::stdout_color_mt("Core");
         s_clientLogger = spdlog::stdout_color_mt("Client");
 
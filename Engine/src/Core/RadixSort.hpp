@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <vector>
+#include <utility>
+
+namespace ant
+{
+    //? stable LSD radix sort over the 64 bit key returned by keyFn, 8 bits per pass
+    //? passes where every item shares the same digit are skipped, scratch is kept by the caller to avoid reallocations
+    template <class T, class KeyFn>
+    void RadixSort64(std::vector<T> &items, std::vector<T> &scratch, KeyFn keyFn)
+    {
+        const size_t count = items.size();
+
+        if (count < 2)
+            return;
+
+        scratch.resize(count);
+
+        std::array<std::array<uint32_t, 256>, 8> histograms{};
+
+        for (const auto &item : items)
+        {
+            uint64_t key = keyFn(item);
+            for (size_t pass = 0; pass < 8; pass++)
+                histograms[pass][(key >> (pass * 8)) & 0xff]++;
+        }
+
+        T *src = items.data();
+        T *dst = scratch.data();
+
+        for (size_t pass = 0; pass < 8; pass++)
+        {
+            auto &histogram = histograms[pass];
+            uint64_t shift = pass * 8;
+
+            if (histogram[(keyFn(src[0]) >> shift) & 0xff] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (auto &bucket : histogram)
+            {
+                uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (size_t i = 0; i < count; i++)
+                dst[histogram[(keyFn(src[i]) >> shift) & 0xff]++] = src[i];
+
+            std::swap(src, dst);
+        }
+
+        if (src != items.data())
+            items.swap(scratch);
+    }
+
+} // namespace ant
@@ -1,19 +1,316 @@
-#include "Random.hpp"
+#include "Pch.h"
+#include "Core/Random.hpp"
+#include "Core/Cpu.hpp"
+#include <atomic>
+#include <random>
+#include <cstring>
+#include <vector>
 
 namespace ant
 {
+    namespace
+    {
+        constexpr uint32_t s_laneCount = 8;
+        constexpr float s_floatUnit = 1.f / 16777216.f; // 2^-24, floats keep 24 bits
+
+        //? state word k of lane i is s[k][i], loads straight into vector registers
+        struct RandomLanes
+        {
+            alignas(32) uint32_t s[4][s_laneCount];
+        };
+
+        struct ThreadState
+        {
+            uint64_t epoch = 0; // s_epoch the state was seeded for, 0 never seeded
+            uint64_t stream = ~0ull;
+            uint64_t s[4];
+            RandomLanes lanes;
+        };
+
+        struct RandomKernel
+        {
+            const char *name;
+            void (*fill)(RandomLanes &lanes, float *out, size_t blocks); // s_laneCount floats per block
+        };
+
+        std::atomic<uint64_t> s_seed = 0;
+        std::atomic<uint64_t> s_epoch = 1;
+        std::atomic<uint64_t> s_nextStream = 1; // 0 belongs to the thread calling Init
+
+        thread_local ThreadState t_state;
+
+        inline uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+        inline uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+        uint64_t SplitMix64(uint64_t &x)
+        {
+            uint64_t z = (x += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+
+        //? xoshiro256+ from "Scrambled Linear Pseudorandom Number Generators", the low bits are weak, use the high ones
+        inline uint64_t Next(uint64_t (&s)[4])
+        {
+            uint64_t result = s[0] + s[3];
+            uint64_t t = s[1] << 17;
+
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = Rotl(s[3], 45);
+
+            return result;
+        }
+
+        void Reseed(ThreadState &state, uint64_t epoch)
+        {
+            if (state.stream == ~0ull)
+                state.stream = s_nextStream.fetch_add(1, std::memory_order_relaxed);
+
+            uint64_t x = s_seed.load(std::memory_order_relaxed) ^ (state.stream * 0xd1342543de82ef95);
+
+            for (auto &word : state.s)
+                word = SplitMix64(x);
+
+            for (auto &words : state.lanes.s)
+                for (uint32_t i = 0; i < s_laneCount; i += 2)
+                {
+                    uint64_t bits = SplitMix64(x);
+                    words[i] = uint32_t(bits);
+                    words[i + 1] = uint32_t(bits >> 32);
+                }
+
+            state.epoch = epoch;
+        }
+
+        inline ThreadState &State()
+        {
+            auto &state = t_state;
+            uint64_t epoch = s_epoch.load(std::memory_order_acquire);
+
+            if (state.epoch != epoch)
+                Reseed(state, epoch);
+
+            return state;
+        }
+
+        //? xoshiro128+ per lane, float from the top 24 bits
+        void FillScalar(RandomLanes &lanes, float *out, size_t blocks)
+        {
+            auto &s = lanes.s;
+
+            for (size_t block = 0; block < blocks; block++, out += s_laneCount)
+                for (uint32_t i = 0; i < s_laneCount; i++)
+                {
+                    uint32_t result = s[0][i] + s[3][i];
+                    uint32_t t = s[1][i] << 9;
+
+                    s[2][i] ^= s[0][i];
+                    s[3][i] ^= s[1][i];
+                    s[1][i] ^= s[2][i];
+                    s[0][i] ^= s[3][i];
+                    s[2][i] ^= t;
+                    s[3][i] = Rotl(s[3][i], 11);
+
+                    out[i] = float(result >> 8) * s_floatUnit;
+                }
+        }
+
+#ifdef ANT_X86_SIMD
+        void FillSse2(RandomLanes &lanes, float *out, size_t blocks)
+        {
+            auto &s = lanes.s;
+            __m128 unit = _mm_set1_ps(s_floatUnit);
+
+            //? two halves of 4 lanes, each keeps its state in registers over the whole fill
+            for (uint32_t half = 0; half < s_laneCount; half += 4)
+            {
+                __m128i s0 = _mm_load_si128((const __m128i *)&s[0][half]);
+                __m128i s1 = _mm_load_si128((const __m128i *)&s[1][half]);
+                __m128i s2 = _mm_load_si128((const __m128i *)&s[2][half]);
+                __m128i s3 = _mm_load_si128((const __m128i *)&s[3][half]);
+
+                for (size_t block = 0; block < blocks; block++)
+                {
+                    __m128i result = _mm_add_epi32(s0, s3);
+                    __m128i t = _mm_slli_epi32(s1, 9);
+
+                    s2 = _mm_xor_si128(s2, s0);
+                    s3 = _mm_xor_si128(s3, s1);
+                    s1 = _mm_xor_si128(s1, s2);
+                    s0 = _mm_xor_si128(s0, s3);
+                    s2 = _mm_xor_si128(s2, t);
+                    s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+                    //? top 24 bits fit a signed int, the conversion is exact like the scalar one
+                    __m128 value = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), unit);
+                    _mm_storeu_ps(out + block * s_laneCount + half, value);
+                }
+
+                _mm_store_si128((__m128i *)&s[0][half], s0);
+                _mm_store_si128((__m128i *)&s[1][half], s1);
+                _mm_store_si128((__m128i *)&s[2][half], s2);
+                _mm_store_si128((__m128i *)&s[3][half], s3);
+            }
+        }
+
+        ANT_TARGET_AVX2 void FillAvx2(RandomLanes &lanes, float *out, size_t blocks)
+        {
+            auto &s = lanes.s;
+            __m256 unit = _mm256_set1_ps(s_floatUnit);
+            __m256i s0 = _mm256_load_si256((const __m256i *)s[0]);
+            __m256i s1 = _mm256_load_si256((const __m256i *)s[1]);
+            __m256i s2 = _mm256_load_si256((const __m256i *)s[2]);
+            __m256i s3 = _mm256_load_si256((const __m256i *)s[3]);
+
+            for (size_t block = 0; block < blocks; block++, out += s_laneCount)
+            {
+                __m256i result = _mm256_add_epi32(s0, s3);
+                __m256i t = _mm256_slli_epi32(s1, 9);
+
+                s2 = _mm256_xor_si256(s2, s0);
+                s3 = _mm256_xor_si256(s3, s1);
+                s1 = _mm256_xor_si256(s1, s2);
+                s0 = _mm256_xor_si256(s0, s3);
+                s2 = _mm256_xor_si256(s2, t);
+                s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+
+                _mm256_storeu_ps(out, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(result, 8)), unit));
+            }
+
+            _mm256_store_si256((__m256i *)s[0], s0);
+            _mm256_store_si256((__m256i *)s[1], s1);
+            _mm256_store_si256((__m256i *)s[2], s2);
+            _mm256_store_si256((__m256i *)s[3], s3);
+        }
+#endif
+
+        //? every kernel this cpu can run, the best one last
+        const std::vector<RandomKernel> &GetKernels()
+        {
+            static const std::vector<RandomKernel> kernels = []
+            {
+                std::vector<RandomKernel> kernels = {{"scalar", FillScalar}};
+#ifdef ANT_X86_SIMD
+                kernels.push_back({"sse2", FillSse2});
+                if (CpuHasAvx2())
+                    kernels.push_back({"avx2", FillAvx2});
+#endif
+                return kernels;
+            }();
+            return kernels;
+        }
+
+        const RandomKernel *&ActiveKernel()
+        {
+            static const RandomKernel *kernel = &GetKernels().back();
+            return kernel;
+        }
+
+        inline const RandomKernel &GetKernel() { return *ActiveKernel(); }
+    } // namespace
+
+    void Random::Init(uint64_t seed)
+    {
+        if (!seed)
+            seed = (uint64_t(std::random_device()()) << 32) | std::random_device()();
+
+        Seed(seed);
+        SetStream(0);
+        CORE_INFO("Random seed {0}, {1} fill kernel", seed, GetKernel().name);
+    }
+
+    void Random::Seed(uint64_t seed)
+    {
+        s_seed.store(seed, std::memory_order_relaxed);
+        s_epoch.fetch_add(1, std::memory_order_release);
+    }
 
-    std::mt19937 Random::s_RandomEngine;
-    std::uniform_int_distribution<std::mt19937::result_type> Random::s_Distribution;
+    uint64_t Random::GetSeed()
+    {
+        return s_seed.load(std::memory_order_relaxed);
+    }
 
-    void Random::Init()
+    void Random::SetStream(uint64_t stream)
     {
-        s_RandomEngine.seed(std::random_device()());
+        t_state.stream = stream;
+        t_state.epoch = 0; // reseeded on the next draw
     }
 
     float Random::Float()
     {
-        return ((float)s_Distribution(s_RandomEngine) / (float)std::numeric_limits<uint_fast32_t>::max());
-    }   
-    
-}
\ No newline at end of file
+        return float(Next(State().s) >> 40) * s_floatUnit;
+    }
+
+    float Random::Float(float min, float max)
+    {
+        return min + (max - min) * Float();
+    }
+
+    uint32_t Random::UInt()
+    {
+        return uint32_t(Next(State().s) >> 32);
+    }
+
+    uint32_t Random::UInt(uint32_t bound)
+    {
+        return uint32_t((uint64_t(UInt()) * bound) >> 32); // multiply shift, bias below bound / 2^32
+    }
+
+    void Random::FillFloats(std::span<float> out)
+    {
+        auto &lanes = State().lanes;
+        auto &kernel = GetKernel();
+        size_t blocks = out.size() / s_laneCount;
+        size_t tail = out.size() % s_laneCount;
+
+        kernel.fill(lanes, out.data(), blocks);
+
+        if (tail)
+        {
+            //? a whole block is drawn for the tail, the rest of it is dropped
+            alignas(32) float last[s_laneCount];
+            kernel.fill(lanes, last, 1);
+            std::copy_n(last, tail, out.data() + blocks * s_laneCount);
+        }
+    }
+
+    void Random::FillFloats(std::span<float> out, float min, float max)
+    {
+        FillFloats(out);
+
+        float range = max - min;
+        for (auto &value : out)
+            value = min + range * value; // vectorized by the compiler
+    }
+
+    const char *Random::GetKernelName()
+    {
+        return GetKernel().name;
+    }
+
+    std::vector<const char *> Random::GetKernelNames()
+    {
+        std::vector<const char *> names;
+        for (auto &kernel : GetKernels())
+            names.push_back(kernel.name);
+        return names;
+    }
+
+    bool Random::SetKernel(const char *name)
+    {
+        for (auto &kernel : GetKernels())
+            if (!std::strcmp(kernel.name, name))
+            {
+                ActiveKernel() = &kernel;
+                return true;
+            }
+
+        return false;
+    }
+
+}
@@ -1,19 +1,42 @@
 #pragma once
-#include <random>
+#include <stdint.h>
+#include <span>
+#include <vector>
 
 namespace ant
 {
-
+    //? every thread draws from its own generator, no locks and no shared state between draws
+    //? single draws use xoshiro256+, bulk fills run 8 xoshiro128+ lanes with sse2 or avx2
+    //? a thread's sequence only depends on the seed and its stream, the same seed replays the same numbers
     class Random
     {
     public:
-        static void Init();
-        
-        static float Float();
+        //! on the main thread before any draw, it takes stream 0, seed 0 picks one from std::random_device
+        static void Init(uint64_t seed = 0);
+
+        //? restarts the sequence of every thread from seed, other threads pick it up on their next draw
+        static void Seed(uint64_t seed);
+        static uint64_t GetSeed();
+
+        //? threads get increasing streams on their first draw, a fixed stream keeps a thread's numbers
+        //? independent of the order threads started in
+        static void SetStream(uint64_t stream);
+
+        static float Float(); // [0, 1)
+        static float Float(float min, float max);
+        static uint32_t UInt();
+        static uint32_t UInt(uint32_t bound); // [0, bound)
+
+        //? same numbers for the scalar, sse2 and avx2 kernels, ranged fills may differ in the last bit
+        static void FillFloats(std::span<float> out); // [0, 1)
+        static void FillFloats(std::span<float> out, float min, float max);
+
+        static const char *GetKernelName();
 
-    private:
-        static std::mt19937 s_RandomEngine;
-        static std::uniform_int_distribution<std::mt19937::result_type> s_Distribution;
+        //? every fill kernel this cpu can run, scalar first, for tests and benchmarks
+        //! SetKernel swaps the kernel of every thread, not while other threads fill
+        static std::vector<const char *> GetKernelNames();
+        static bool SetKernel(const char *name); // false for a kernel this cpu can't run
     };
 
-}
\ No newline at end of file
+}
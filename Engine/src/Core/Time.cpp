@@ -1,5 +1,5 @@
 #include "Core/Time.hpp"
-#include <GLFW/glfw3.h>
+#include <chrono>
 
 namespace ant
 {
@@ -12,7 +12,9 @@ namespace ant
 
     void TimeStep::UpdateFrameTime(TimeStep& lastFrameTime)
     {
-        TimeStep time = glfwGetTime();
+        //? not glfwGetTime, the null backend never starts glfw
+        static const auto start = std::chrono::steady_clock::now();
+        TimeStep time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
         s_frameTime = time - lastFrameTime;
         lastFrameTime = time;
     }
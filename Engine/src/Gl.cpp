@@ -0,0 +1,20 @@
+#define ANT_GL_DISPATCH_IMPL
+#include "Gl.h"
+
+namespace ant::gl
+{
+#define ANT_GL_DEFINE(Name) decltype(&::gl##Name) Name = &::gl##Name;
+    ANT_GL11_ENTRY_POINTS(ANT_GL_DEFINE)
+#undef ANT_GL_DEFINE
+
+    void LoadEntryPoints(GLFWglproc (*loader)(const char *name))
+    {
+#define ANT_GL_LOAD(Name) Name = reinterpret_cast<decltype(Name)>(loader("gl" #Name));
+        ANT_GL11_ENTRY_POINTS(ANT_GL_LOAD)
+#undef ANT_GL_LOAD
+
+#define ANT_GLEW_LOAD(Name) __glew##Name = reinterpret_cast<decltype(__glew##Name)>(loader("gl" #Name));
+        ANT_GLEW_ENTRY_POINTS(ANT_GLEW_LOAD)
+#undef ANT_GLEW_LOAD
+    }
+} // namespace ant::gl
@@ -3,4 +3,117 @@
 #define GLEW_STATIC 
 #include <GL/glew.h> 
  
-#include <GLFW/glfw3.h> 
\ No newline at end of file
+#include <GLFW/glfw3.h>
+
+//? every gl entry point the engine calls, X(Name) for glName
+//? the 1.1 ones are linked directly by glew, they go through the ant::gl pointers below so they can be replaced like the rest
+#define ANT_GL11_ENTRY_POINTS(X) \
+    X(BlendFunc)                 \
+    X(Clear)                     \
+    X(ClearColor)                \
+    X(ClearDepth)                \
+    X(DeleteTextures)            \
+    X(DepthFunc)                 \
+    X(DrawElements)              \
+    X(Enable)                    \
+    X(GetIntegerv)               \
+    X(GetString)                 \
+    X(Viewport)
+
+//? loaded by glewInit into the __glewName pointers
+#define ANT_GLEW_ENTRY_POINTS(X)        \
+    X(AttachShader)                     \
+    X(BindBuffer)                       \
+    X(BindBufferBase)                   \
+    X(BindFramebuffer)                  \
+    X(BindTextureUnit)                  \
+    X(BindVertexArray)                  \
+    X(BufferData)                       \
+    X(CheckFramebufferStatus)           \
+    X(ClientWaitSync)                   \
+    X(CompileShader)                    \
+    X(CopyImageSubData)                 \
+    X(CreateBuffers)                    \
+    X(CreateProgram)                    \
+    X(CreateShader)                     \
+    X(CreateTextures)                   \
+    X(CreateVertexArrays)               \
+    X(DebugMessageCallback)             \
+    X(DeleteBuffers)                    \
+    X(DeleteFramebuffers)               \
+    X(DeleteProgram)                    \
+    X(DeleteShader)                     \
+    X(DeleteSync)                       \
+    X(DeleteVertexArrays)               \
+    X(DisableVertexAttribArray)         \
+    X(DispatchCompute)                  \
+    X(DrawArraysIndirect)               \
+    X(DrawArraysInstancedBaseInstance)  \
+    X(DrawElementsBaseVertex)           \
+    X(EnableVertexAttribArray)          \
+    X(FenceSync)                        \
+    X(FramebufferTexture2D)             \
+    X(GenFramebuffers)                  \
+    X(GenVertexArrays)                  \
+    X(GetInteger64v)                    \
+    X(GetNamedBufferSubData)            \
+    X(GetShaderInfoLog)                 \
+    X(GetShaderiv)                      \
+    X(GetTextureHandleARB)              \
+    X(GetTextureImage)                  \
+    X(GetUniformLocation)               \
+    X(LinkProgram)                      \
+    X(MakeTextureHandleNonResidentARB)  \
+    X(MakeTextureHandleResidentARB)     \
+    X(MapNamedBufferRange)              \
+    X(MemoryBarrier)                    \
+    X(NamedBufferStorage)               \
+    X(NamedBufferSubData)               \
+    X(ShaderSource)                     \
+    X(TextureParameteri)                \
+    X(TextureStorage2D)                 \
+    X(TextureStorage3D)                 \
+    X(TextureSubImage2D)                \
+    X(Uniform1f)                        \
+    X(Uniform1i)                        \
+    X(Uniform1iv)                       \
+    X(Uniform2f)                        \
+    X(Uniform2i)                        \
+    X(Uniform3f)                        \
+    X(Uniform3i)                        \
+    X(Uniform4f)                        \
+    X(Uniform4i)                        \
+    X(UniformMatrix2fv)                 \
+    X(UniformMatrix3fv)                 \
+    X(UniformMatrix4fv)                 \
+    X(UnmapNamedBuffer)                 \
+    X(UseProgram)                       \
+    X(ValidateProgram)                  \
+    X(VertexAttribDivisor)              \
+    X(VertexAttribIPointer)             \
+    X(VertexAttribPointer)
+
+namespace ant::gl
+{
+#define ANT_GL_DECLARE(Name) extern decltype(&::gl##Name) Name;
+    ANT_GL11_ENTRY_POINTS(ANT_GL_DECLARE)
+#undef ANT_GL_DECLARE
+
+    //? points every entry point of the lists above at what loader returns
+    //? for contexts glew can't load, an osmesa context answers its own glXGetProcAddress calls with nothing
+    void LoadEntryPoints(GLFWglproc (*loader)(const char *name));
+} // namespace ant::gl
+
+#ifndef ANT_GL_DISPATCH_IMPL
+#define glBlendFunc ::ant::gl::BlendFunc
+#define glClear ::ant::gl::Clear
+#define glClearColor ::ant::gl::ClearColor
+#define glClearDepth ::ant::gl::ClearDepth
+#define glDeleteTextures ::ant::gl::DeleteTextures
+#define glDepthFunc ::ant::gl::DepthFunc
+#define glDrawElements ::ant::gl::DrawElements
+#define glEnable ::ant::gl::Enable
+#define glGetIntegerv ::ant::gl::GetIntegerv
+#define glGetString ::ant::gl::GetString
+#define glViewport ::ant::gl::Viewport
+#endif
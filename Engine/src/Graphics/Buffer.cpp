@@ -27,7 +27,7 @@ namespace ant
 
     void Buffer::Bind()
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
         BindVertexArrayObj();
         glBindBuffer(m_glBufferType, m_glId);
     }
@@ -39,7 +39,7 @@ namespace ant
 
     void Buffer::BufferData(void *array, size_t size, bool dynamicDraw)
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
         Create();
         Bind();
         glBufferData(m_glBufferType, 4 * size, array, (dynamicDraw ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW));
@@ -84,16 +84,111 @@ namespace ant
 
     void VertexArrayPrimitive::Bind()
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
         m_vertexBuffer.Bind();
         m_indexBuffer.Bind();
     }
 
     void VertexBuffer::UpdateLayout()
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
         m_glVertexArray.Bind();
         m_layout.SetAttribPtrs();
     }
 
+    StreamBuffer::StreamBuffer(BufferType bufferType, size_t regionSize, uint32_t regionCount)
+        : Buffer(bufferType), m_regionSize(regionSize), m_regionCount(regionCount), m_fences(regionCount, nullptr)
+    {
+        Create();
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+        for (auto &fence : m_fences)
+            glDeleteSync((GLsync)fence);
+
+        glUnmapNamedBuffer(m_glId);
+    }
+
+    void StreamBuffer::Create()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        size_t size = m_regionSize * m_regionCount;
+
+        glCreateBuffers(1, &m_glId);
+        glNamedBufferStorage(m_glId, size, nullptr, flags);
+        m_mappedPtr = (uint8_t *)glMapNamedBufferRange(m_glId, 0, size, flags);
+
+        CORE_ASSERT(m_mappedPtr, "Failed to map stream buffer!");
+    }
+
+    bool StreamBuffer::Acquire()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        GLsync fence = (GLsync)m_fences[m_region];
+
+        if (!fence)
+            return false;
+
+        bool stalled = false;
+        GLenum state = glClientWaitSync(fence, 0, 0);
+
+        while (state == GL_TIMEOUT_EXPIRED)
+        {
+            stalled = true;
+            state = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        }
+
+        CORE_ASSERT(state != GL_WAIT_FAILED, "Waiting on stream buffer fence failed!");
+
+        glDeleteSync(fence);
+        m_fences[m_region] = nullptr;
+        return stalled;
+    }
+
+    void StreamBuffer::Release()
+    {
+        m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_region = (m_region + 1) % m_regionCount;
+    }
+
+    StreamVertexArray::StreamVertexArray(const VertexBufferLayout &layout, size_t verticesPerRegion, uint32_t regionCount, uint32_t attribDivisor)
+        : m_layout(layout),
+          m_vertexBuffer(BufferType::VertexBuffer, verticesPerRegion * layout.GetStride(), regionCount)
+    {
+        glGenVertexArrays(1, &m_glId);
+        glBindVertexArray(m_glId);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer.GetGlId());
+        m_layout.SetAttribPtrs(attribDivisor);
+        glBindVertexArray(0);
+    }
+
+    StreamVertexArray::~StreamVertexArray()
+    {
+        glDeleteVertexArrays(1, &m_glId);
+    }
+
+    void StreamVertexArray::Bind()
+    {
+        glBindVertexArray(m_glId);
+    }
+
+    bool StreamVertexArray::Acquire()
+    {
+        return m_vertexBuffer.Acquire();
+    }
+
+    void StreamVertexArray::Release()
+    {
+        m_vertexBuffer.Release();
+    }
+
+    void StreamVertexArray::SetIndexData(uint32_t *array, size_t size)
+    {
+        glBindVertexArray(m_glId);
+        m_indexBuffer.UploadData(array, size); // element buffer binding is stored in vao state
+        glBindVertexArray(0);
+    }
+
 } // namespace ant
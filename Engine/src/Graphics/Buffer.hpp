@@ -142,4 +142,56 @@ namespace ant
 		IndexBuffer m_indexBuffer;
 	};
 
+	//? persistently mapped buffer split into regions, each region is guarded by a fence
+	class StreamBuffer
+		: public Buffer
+	{
+	public:
+		StreamBuffer(BufferType bufferType, size_t regionSize, uint32_t regionCount = 3);
+		~StreamBuffer();
+
+		virtual void Create() override;
+		virtual inline void BindVertexArrayObj() override {}
+
+		bool Acquire(); // returns true when gpu still used the region and we had to wait
+		void Release();
+
+		inline void *GetRegionPtr() const { return m_mappedPtr + GetRegionOffset(); }
+		inline size_t GetRegionOffset() const { return m_regionSize * m_region; }
+		inline size_t GetRegionSize() const { return m_regionSize; }
+		inline uint32_t GetGlId() const { return m_glId; }
+
+	private:
+		uint8_t *m_mappedPtr = nullptr;
+		size_t m_regionSize;
+		uint32_t m_regionCount;
+		uint32_t m_region = 0;
+		std::vector<void *> m_fences; // GLsync
+	};
+
+	class StreamVertexArray
+	{
+	public:
+		StreamVertexArray(const VertexBufferLayout &layout, size_t verticesPerRegion, uint32_t regionCount = 3, uint32_t attribDivisor = 0);
+		~StreamVertexArray();
+
+		void Bind();
+		bool Acquire();
+		void Release();
+
+		//? indices are static and shared by every region, vertices are addressed through the base vertex
+		void SetIndexData(uint32_t *array, size_t size);
+
+		template <class T>
+		inline T *GetVertexPtr() { return (T *)m_vertexBuffer.GetRegionPtr(); }
+		inline int32_t GetBaseVertex() const { return m_vertexBuffer.GetRegionOffset() / m_layout.GetStride(); }
+		inline uint32_t GetBaseInstance() const { return GetBaseVertex(); }
+
+	private:
+		uint32_t m_glId;
+		VertexBufferLayout m_layout;
+		StreamBuffer m_vertexBuffer;
+		IndexBuffer m_indexBuffer;
+	};
+
 } // namespace ant
@@ -35,6 +35,13 @@ namespace ant
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    std::vector<uint8_t> FrameBuffer::ReadPixels() const
+    {
+        std::vector<uint8_t> pixels(size_t(m_width) * m_height * 4);
+        glGetTextureImage(m_colorBufferId, 0, GL_RGBA, GL_UNSIGNED_BYTE, GLsizei(pixels.size()), pixels.data());
+        return pixels;
+    }
+
     void FrameBuffer::Resize(uint32_t width, uint32_t height)
     {
         m_width = width;
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Core.hpp"
+#include <vector>
 
 namespace ant
 {
@@ -21,6 +22,9 @@ namespace ant
 
         uint32_t GetGlId() const { return m_colorBufferId; }
 
+        //? the color attachment as rgba8, rows bottom up, how an offscreen run checks what it drew
+        std::vector<uint8_t> ReadPixels() const;
+
     private:
         uint32_t m_width, m_height;
         uint32_t m_colorBufferId = 0, m_depthBufferId = 0, m_frameBufferGlId = 0;
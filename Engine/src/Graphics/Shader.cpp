@@ -4,6 +4,7 @@
 #include <Gl.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <filesystem>
+#include "debug/Metrics.hpp"
 
 namespace ant
 {
@@ -33,6 +34,8 @@ namespace ant
 			return DataType::ivec4;
 		if (name == "sampler2D")
 			return DataType::ivec1;
+		if (name == "sampler2DArray")
+			return DataType::ivec1;
 		return DataType::incorrect;
 	}
 
@@ -124,9 +127,30 @@ namespace ant
 		glDeleteProgram(m_shaderId);
 	}
 
+	void Shader::CreateShader()
+	{
+		if (!m_source.compute.empty())
+			CreateComputeShader(m_source.compute);
+		else
+			CreateShader(m_source.vertex, m_source.fragment);
+	}
+
+	void Shader::CreateComputeShader(const std::string &computeShader)
+	{
+		CORE_PROFILE_FUNC_CAT(Assets);
+		m_shaderId = glCreateProgram();
+		uint32_t cs = CompileShader(computeShader, GL_COMPUTE_SHADER);
+
+		glAttachShader(m_shaderId, cs);
+		glLinkProgram(m_shaderId);
+		glValidateProgram(m_shaderId);
+
+		glDeleteShader(cs);
+	}
+
 	void Shader::CreateShader(const std::string &vertexShader, const std::string &fragmentShader)
 	{
-		CORE_PROFILE_FUNC();
+		CORE_PROFILE_FUNC_CAT(Assets);
 		m_shaderId = glCreateProgram();
 		uint32_t vs = CompileShader(vertexShader, GL_VERTEX_SHADER);
 		uint32_t fs = CompileShader(fragmentShader, GL_FRAGMENT_SHADER);
@@ -143,7 +167,7 @@ namespace ant
 
 	void Shader::LoadFromFile(const std::string &filePath)
 	{
-		CORE_PROFILE_FUNC();
+		CORE_PROFILE_FUNC_CAT(Assets);
 
 		CORE_ASSERT(
         std::filesystem::exists(filePath),"Cannot find shader file! " + filePath);
@@ -154,14 +178,16 @@ namespace ant
 		enum : uint8_t
 		{
 			vertex = 0,
-			fragment = 1
+			fragment = 1,
+			compute = 2
 		};
 
 		uint8_t type = vertex;
 
-		std::string *shaderSrcPtr[2] = {
+		std::string *shaderSrcPtr[3] = {
 			&m_source.vertex,
-			&m_source.fragment};
+			&m_source.fragment,
+			&m_source.compute};
 
 		while (std::getline(file, line))
 		{
@@ -177,6 +203,12 @@ namespace ant
 				continue;
 			}
 
+			if (!line.compare("#computeShader"))
+			{
+				type = compute;
+				continue;
+			}
+
 			line.push_back('\n');
 
 			shaderSrcPtr[type]->append(line);
@@ -224,7 +256,7 @@ namespace ant
 
 	Uniform &Shader::SetUniform(const std::string &name)
 	{
-		CORE_PROFILE_FUNC();
+		CORE_PROFILE_FUNC_CAT(Assets);
 		auto &un = m_uniforms[name];
 		un.SetUniformId(name, m_shaderId);
 		return un;
@@ -232,7 +264,9 @@ namespace ant
 
 	int Shader::CompileShader(const std::string &source, uint32_t type)
 	{
-		CORE_PROFILE_FUNC();
+		CORE_PROFILE_FUNC_CAT(Assets);
+		static auto &compiled = Metrics::GetCounter("assets.shaders compiled");
+		compiled.Add();
 		uint32_t id = glCreateShader(type);
 		const char *src = source.c_str();
 
@@ -249,7 +283,7 @@ namespace ant
 			glGetShaderiv(id, GL_INFO_LOG_LENGTH, &len);
 			char *mes = (char *)alloca(len);
 			glGetShaderInfoLog(id, len, &len, mes);
-			ss << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment") << " shader compilation failed! " << mes;
+			ss << (type == GL_VERTEX_SHADER ? "Vertex" : type == GL_FRAGMENT_SHADER ? "Fragment" : "Compute") << " shader compilation failed! " << mes;
 			CORE_ASSERT(false, ss.str());
 			glDeleteShader(id);
 			return 0;
@@ -260,7 +294,7 @@ namespace ant
 
 	void Material::Use()
 	{
-		CORE_PROFILE_FUNC();
+		CORE_PROFILE_FUNC_CAT(Assets);
 		m_shader->BindShader();
 
 		for (auto &it : m_shader->m_uniforms)
@@ -81,8 +81,10 @@ namespace ant
         Shader(const std::string &filePath) { LoadFromFile(filePath); }
         ~Shader();
 
-        inline void CreateShader() { CreateShader(m_source.vertex, m_source.fragment); }
+        //? files with a #computeShader section become compute programs
+        void CreateShader();
         void CreateShader(const std::string &vertexShader, const std::string &fragmentShader);
+        void CreateComputeShader(const std::string &computeShader);
         void LoadFromFile(const std::string &filePath);
         Uniform &SetUniform(const std::string &name);
         void BindShader();
@@ -96,6 +98,7 @@ namespace ant
         {
             std::string fragment;
             std::string vertex;
+            std::string compute;
         };
 
         uint32_t m_shaderId;
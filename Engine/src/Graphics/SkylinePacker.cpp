@@ -0,0 +1,140 @@
+#include "Graphics/SkylinePacker.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace ant
+{
+    SkylinePacker::SkylinePacker(const glm::ivec2 &size)
+        : m_size(size)
+    {
+        m_skyline.push_back({0, 0, size.x});
+    }
+
+    bool SkylinePacker::Fit(size_t index, const glm::ivec2 &size, int32_t &y) const
+    {
+        int32_t x = m_skyline[index].x;
+
+        if (x + size.x > m_size.x)
+            return false;
+
+        int32_t widthLeft = size.x;
+        y = m_skyline[index].y;
+
+        for (size_t i = index; widthLeft > 0; i++)
+        {
+            y = std::max(y, m_skyline[i].y);
+
+            if (y + size.y > m_size.y)
+                return false;
+
+            widthLeft -= m_skyline[i].width;
+        }
+
+        return true;
+    }
+
+    bool SkylinePacker::Insert(const glm::ivec2 &size, glm::ivec2 &position)
+    {
+        size_t bestIndex = m_skyline.size();
+        int32_t bestY = std::numeric_limits<int32_t>::max();
+        int32_t bestWidth = std::numeric_limits<int32_t>::max();
+
+        //? lowest resulting top edge wins, narrower skyline segment breaks ties
+        for (size_t i = 0; i < m_skyline.size(); i++)
+        {
+            int32_t y;
+            if (!Fit(i, size, y))
+                continue;
+
+            if (y + size.y < bestY || (y + size.y == bestY && m_skyline[i].width < bestWidth))
+            {
+                bestIndex = i;
+                bestY = y + size.y;
+                bestWidth = m_skyline[i].width;
+            }
+        }
+
+        if (bestIndex == m_skyline.size())
+            return false;
+
+        position = {m_skyline[bestIndex].x, bestY - size.y};
+        m_skyline.insert(m_skyline.begin() + bestIndex, {position.x, bestY, size.x});
+
+        // shrink or remove segments now hidden below the new one
+        for (size_t i = bestIndex + 1; i < m_skyline.size();)
+        {
+            auto &prev = m_skyline[i - 1];
+            auto &node = m_skyline[i];
+            int32_t overlap = prev.x + prev.width - node.x;
+
+            if (overlap <= 0)
+                break;
+
+            node.x += overlap;
+            node.width -= overlap;
+
+            if (node.width > 0)
+                break;
+
+            m_skyline.erase(m_skyline.begin() + i);
+        }
+
+        // merge neighbours of equal height
+        for (size_t i = 0; i + 1 < m_skyline.size();)
+        {
+            if (m_skyline[i].y == m_skyline[i + 1].y)
+            {
+                m_skyline[i].width += m_skyline[i + 1].width;
+                m_skyline.erase(m_skyline.begin() + i + 1);
+            }
+            else
+                i++;
+        }
+
+        m_usedArea += uint64_t(size.x) * size.y;
+        return true;
+    }
+
+    PackedLayout PackSkyline(const std::vector<glm::ivec2> &sizes, const glm::ivec2 &pageSize, int32_t padding)
+    {
+        PackedLayout layout;
+        layout.rects.resize(sizes.size());
+        std::vector<SkylinePacker> pages;
+
+        //? placing tall images first keeps the skyline flat
+        std::vector<uint32_t> order(sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r)
+                         { return sizes[l].y > sizes[r].y; });
+
+        for (uint32_t index : order)
+        {
+            glm::ivec2 padded = sizes[index] + 2 * padding;
+            auto &rect = layout.rects[index];
+
+            if (padded.x > pageSize.x || padded.y > pageSize.y)
+                continue;
+
+            glm::ivec2 position;
+            for (size_t i = 0; i < pages.size() && rect.page < 0; i++)
+            {
+                if (pages[i].Insert(padded, position))
+                    rect.page = i;
+            }
+
+            if (rect.page < 0)
+            {
+                pages.emplace_back(pageSize);
+                pages.back().Insert(padded, position);
+                rect.page = pages.size() - 1;
+            }
+
+            rect.position = position + padding;
+        }
+
+        layout.pageCount = pages.size();
+        return layout;
+    }
+
+} // namespace ant
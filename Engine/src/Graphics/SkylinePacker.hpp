@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace ant
+{
+    //? where PackSkyline put one image, position is the corner of the image inside its padding
+    struct PackedRect
+    {
+        int32_t page = -1; // -1 when the padded image is bigger than a page
+        glm::ivec2 position = {0, 0};
+    };
+
+    struct PackedLayout
+    {
+        std::vector<PackedRect> rects; // in the order of the sizes
+        uint32_t pageCount = 0;
+    };
+
+    //? skyline bottom-left rectangle packer for one page, cpu only
+    class SkylinePacker
+    {
+    public:
+        SkylinePacker(const glm::ivec2 &size);
+        ~SkylinePacker() {}
+
+        bool Insert(const glm::ivec2 &size, glm::ivec2 &position);
+        inline uint64_t GetUsedArea() const { return m_usedArea; }
+        inline const glm::ivec2 &GetSize() const { return m_size; }
+
+    private:
+        bool Fit(size_t index, const glm::ivec2 &size, int32_t &y) const;
+
+    private:
+        struct Node
+        {
+            int32_t x, y, width;
+        };
+
+        std::vector<Node> m_skyline;
+        glm::ivec2 m_size;
+        uint64_t m_usedArea = 0;
+    };
+
+    //? packs the sizes into as many pages as needed, tallest first, each image gets padding on every side
+    //? no textures and no gl involved, TextureAtlas::Pack blits the images into the layout afterwards
+    PackedLayout PackSkyline(const std::vector<glm::ivec2> &sizes, const glm::ivec2 &pageSize, int32_t padding);
+
+} // namespace ant
@@ -4,11 +4,13 @@
 #include <stb_image.h>
 #include <Gl.h>
 #include <filesystem>
+#include "debug/Metrics.hpp"
 
 namespace ant
 {
 
     std::unordered_map<std::string,Ref<Texture>> Texture::s_loadedTextures;
+    uint32_t Texture::s_nextId = 1; // 0 is left for untextured draws
 
     Ref<Texture> Texture::Create(const std::string &filePath)
     {
@@ -17,9 +19,11 @@ namespace ant
             return s_loadedTextures[filePath];
         }
 
+        static auto &loaded = Metrics::GetCounter("assets.textures loaded");
         auto ref = MakeRef<Texture>();
         ref->LoadFromFile(filePath);
         s_loadedTextures[filePath] = ref;
+        loaded.Add();
 
         return ref;
     }
@@ -32,7 +36,7 @@ namespace ant
         return ref;
     }
 
-    Texture::Texture(bool keepLocalBuffer) : m_keepLocalBuffer(keepLocalBuffer), m_dimensions(0), m_internalFormat(GL_RGBA8), m_subimageFormat(GL_RGBA)
+    Texture::Texture(bool keepLocalBuffer) : m_id(s_nextId++), m_keepLocalBuffer(keepLocalBuffer), m_dimensions(0), m_internalFormat(GL_RGBA8), m_subimageFormat(GL_RGBA)
     {
         glCreateTextures(GL_TEXTURE_2D, 1, &m_glId);
     }
@@ -44,6 +48,9 @@ namespace ant
             stbi_image_free(m_rawData);
             m_rawData = nullptr;
         }
+        if (m_bindlessHandle)
+            glMakeTextureHandleNonResidentARB(m_bindlessHandle);
+
         glDeleteTextures(1, &m_glId);
 
         //! textures loaded one never disappear there is always last reference in s_loadedTextures map
@@ -62,27 +69,45 @@ namespace ant
         m_uploaded = false;
     }
 
-    void Texture::Upload(uint32_t slot)
+    void Texture::UploadStorage()
     {
-        if (!m_uploaded)
-        {
-            glTextureStorage2D(m_glId, 1, m_internalFormat, m_dimensions.x, m_dimensions.y);
+        if (m_uploaded)
+            return;
 
-            glTextureParameteri(m_glId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTextureParameteri(m_glId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        static auto &uploads = Metrics::GetCounter("assets.texture uploads");
+        uploads.Add();
 
-            glTextureSubImage2D(m_glId, 0, 0, 0, m_dimensions.x, m_dimensions.y, m_subimageFormat, GL_UNSIGNED_BYTE, m_rawData);
+        glTextureStorage2D(m_glId, 1, m_internalFormat, m_dimensions.x, m_dimensions.y);
 
-            m_uploaded = true;
-        }
+        glTextureParameteri(m_glId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(m_glId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTextureSubImage2D(m_glId, 0, 0, 0, m_dimensions.x, m_dimensions.y, m_subimageFormat, GL_UNSIGNED_BYTE, m_rawData);
+
+        m_uploaded = true;
+    }
+
+    void Texture::Upload(uint32_t slot)
+    {
+        UploadStorage();
 
-        if (slot != m_slot)
+        //? redundant binds are filtered by the caller (Renderer2D keeps a table of bound units)
+        m_slot = slot;
+        glBindTextureUnit(slot, m_glId);
+    }
+ 
+    uint64_t Texture::GetBindlessHandle()
+    {
+        if (!m_bindlessHandle)
         {
-            m_slot = slot;
-            glBindTextureUnit(slot, m_glId);
+            UploadStorage();
+            m_bindlessHandle = glGetTextureHandleARB(m_glId);
+            glMakeTextureHandleResidentARB(m_bindlessHandle);
         }
+
+        return m_bindlessHandle;
     }
- 
+
     void Texture::ClearLocalBuffer()
     {
         stbi_image_free(m_rawData);
@@ -91,18 +116,30 @@ namespace ant
 
     void Texture::SetData(void *data, int32_t size)
     {
-        int32_t bpp = m_subimageFormat == GL_RGBA ? 4 : 3;
-        CORE_ASSERT(size == m_dimensions.x * m_dimensions.y * bpp, "Incorrect texture data format or size set!");
+        CORE_ASSERT(size == m_dimensions.x * m_dimensions.y * int32_t(m_channelCount), "Incorrect texture data format or size set!");
         stbi_image_free(m_rawData);
         m_rawData = (uchar *)data;
         m_slot = -1;
         m_uploaded = false;
     }
 
+    uint32_t Texture::GetChannelCount() const
+    {
+        return m_channelCount;
+    }
+
     void Texture::SetFormat(uint32_t channelCount)
     {
         switch (channelCount)
         {
+        case 1:
+            m_internalFormat = GL_R8;
+            m_subimageFormat = GL_RED;
+            break;
+        case 2:
+            m_internalFormat = GL_RG8;
+            m_subimageFormat = GL_RG;
+            break;
         case 3:
             m_internalFormat = GL_RGB8;
             m_subimageFormat = GL_RGB;
@@ -113,8 +150,14 @@ namespace ant
             break;
 
         default:
+            CORE_WARN("Textures with {0} channels are not supported, treating it as RGBA", channelCount);
+            channelCount = 4;
+            m_internalFormat = GL_RGBA8;
+            m_subimageFormat = GL_RGBA;
             break;
         }
+
+        m_channelCount = channelCount;
     }
 
     Ref<SubTexture> SubTexture::Create(Ref<Texture> tex, const glm::vec2 &indecies, const glm::vec2 &tileSize, const glm::vec2 &cellSize)
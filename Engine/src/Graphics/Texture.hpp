@@ -6,9 +6,13 @@
 
 namespace ant
 {
+    class TextureArray;
 
     class Texture
     {
+        friend class Renderer2D;
+        friend class TextureArray;
+
     public:
         inline static Ref<Texture> Create() { return MakeRef<Texture>(); }
         static Ref<Texture> Create(const std::string &filePath);
@@ -25,22 +29,36 @@ namespace ant
         void SetKeepLocalBuffer(bool keep = true) { m_keepLocalBuffer = keep; }
         void SetData(void *data, int32_t size);
         inline const glm::ivec2 &GetSize() const { return m_dimensions; }
+        inline const uchar *GetData() const { return m_rawData; }
+        uint32_t GetChannelCount() const;
         int32_t GetSlot() { return m_slot; }
+        inline uint32_t GetId() const { return m_id; } // unique per texture, used for sort keys
+        uint64_t GetBindlessHandle(); //! ARB_bindless_texture only, makes the texture resident and immutable
 
     private:
         void SetFormat(uint32_t channelCount);
+        void UploadStorage();
 
     private:
         static std::unordered_map<std::string,Ref<Texture>> s_loadedTextures;
+        static uint32_t s_nextId;
 
         uint32_t m_glId;
+        uint32_t m_id;
         uchar *m_rawData = nullptr;
         glm::ivec2 m_dimensions;
         bool m_keepLocalBuffer;
         bool m_uploaded = false;
         int32_t m_slot = -1;
+        uint32_t m_batchEpoch = 0; // Renderer2D batch this texture was last assigned a slot in
+        uint64_t m_bindlessHandle = 0;
+        int32_t m_bindlessIndex = -1; // position in the Renderer2D handle table
+        TextureArray *m_array = nullptr;
+        uint32_t m_arrayLayer = 0;
+        uint32_t m_arrayRejected = 0; // arrays generation of Renderer2D that sent it to a plain unit, 0 never
         uint32_t m_internalFormat;
         uint32_t m_subimageFormat;
+        uint32_t m_channelCount = 4; // of m_rawData
     };
 
     struct TextureRect
@@ -62,6 +80,7 @@ namespace ant
 
         void SetRegion(const TextureRect &region);        
         Ref<Texture> GetTexture() const { return m_mainTexture; }
+        void SetTexture(Ref<Texture> tex) { m_mainTexture = tex; } // call SetRegion afterwards, coordinates depend on the texture size
 
     private:
         std::array<glm::vec2, 4> GetCoordinateData() const { return m_coordinates; }
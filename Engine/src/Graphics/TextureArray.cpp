@@ -0,0 +1,80 @@
+#include "Pch.h"
+#include "Graphics/TextureArray.hpp"
+
+#include <Gl.h>
+
+namespace ant
+{
+    uint32_t TextureArray::s_nextId = 1;
+
+    bool TextureArray::CanHold(const Texture &texture)
+    {
+        return texture.m_internalFormat == GL_RGBA8;
+    }
+
+    TextureArray::TextureArray(const glm::ivec2 &size, uint32_t layerLimit)
+        : m_id(s_nextId++), m_size(size), m_layerLimit(layerLimit)
+    {
+        Grow();
+    }
+
+    void TextureArray::Grow()
+    {
+        CORE_PROFILE_FUNC_CAT(Assets);
+        uint32_t capacity = GetNextCapacity();
+        uint32_t glId;
+
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &glId);
+        glTextureStorage3D(glId, 1, GL_RGBA8, m_size.x, m_size.y, capacity);
+
+        glTextureParameteri(glId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(glId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        if (m_glId)
+        {
+            if (m_layerCount)
+                glCopyImageSubData(m_glId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                                   glId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                                   m_size.x, m_size.y, m_layerCount);
+
+            glDeleteTextures(1, &m_glId);
+            m_id = s_nextId++; //? units still holding the old storage no longer match the id
+        }
+
+        m_glId = glId;
+        m_capacity = capacity;
+    }
+
+    TextureArray::~TextureArray()
+    {
+        glDeleteTextures(1, &m_glId);
+    }
+
+    uint32_t TextureArray::AddLayer(Texture &texture)
+    {
+        CORE_PROFILE_FUNC_CAT(Assets);
+        CORE_ASSERT(!IsFull(), "Texture array is full!");
+        CORE_ASSERT(texture.GetSize() == m_size && CanHold(texture), "Texture does not match the texture array format!");
+
+        texture.UploadStorage();
+
+        if (m_layerCount == m_capacity)
+            Grow();
+
+        uint32_t layer = m_layerCount++;
+        glCopyImageSubData(texture.m_glId, GL_TEXTURE_2D, 0, 0, 0, 0,
+                           m_glId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+                           m_size.x, m_size.y, 1);
+
+        texture.m_array = this;
+        texture.m_arrayLayer = layer;
+        return layer;
+    }
+
+    void TextureArray::Bind(uint32_t slot)
+    {
+        m_slot = slot;
+        glBindTextureUnit(slot, m_glId);
+    }
+
+} // namespace ant
@@ -0,0 +1,55 @@
+#pragma once
+#include "Core/Core.hpp"
+#include "Graphics/Texture.hpp"
+#include <glm/vec2.hpp>
+#include <algorithm>
+
+namespace ant
+{
+
+    //? GL_TEXTURE_2D_ARRAY of same sized RGBA8 layers, filled by copying already uploaded textures on the gpu
+    //? storage starts at a few layers and doubles up to layerLimit, growing copies the layers into new storage
+    class TextureArray
+    {
+        friend class Renderer2D;
+
+    public:
+        static constexpr uint32_t initialLayers = 4;
+
+        static Ref<TextureArray> Create(const glm::ivec2 &size, uint32_t layerLimit) { return MakeRef<TextureArray>(size, layerLimit); }
+        static bool CanHold(const Texture &texture); // only RGBA8 textures can be copied into a layer
+
+        TextureArray(const glm::ivec2 &size, uint32_t layerLimit);
+        ~TextureArray();
+
+        //? returns the layer index and links the texture to this array
+        //! growing replaces the gl texture and the id, units holding the array have to be bound again
+        uint32_t AddLayer(Texture &texture);
+        void Bind(uint32_t slot);
+
+        inline bool IsFull() const { return m_layerCount == m_layerLimit; }
+        inline const glm::ivec2 &GetSize() const { return m_size; }
+        inline uint32_t GetId() const { return m_id; }
+
+        inline size_t GetLayerBytes() const { return size_t(m_size.x) * m_size.y * 4; }
+        inline size_t GetAllocatedBytes() const { return GetLayerBytes() * m_capacity; }
+        inline size_t GetGrowthBytes() const { return m_layerCount == m_capacity && !IsFull() ? GetLayerBytes() * (GetNextCapacity() - m_capacity) : 0; } // added by the next AddLayer
+
+    private:
+        inline uint32_t GetNextCapacity() const { return std::min(m_capacity ? 2 * m_capacity : initialLayers, m_layerLimit); }
+        void Grow();
+
+    private:
+        static uint32_t s_nextId;
+
+        uint32_t m_glId = 0;
+        uint32_t m_id;
+        glm::ivec2 m_size;
+        uint32_t m_layerCount = 0;
+        uint32_t m_capacity = 0; // layers of the current storage
+        uint32_t m_layerLimit;
+        int32_t m_slot = -1;
+        uint32_t m_batchEpoch = 0; // same meaning as Texture::m_batchEpoch
+    };
+
+} // namespace ant
@@ -0,0 +1,159 @@
+#include "Pch.h"
+#include "Graphics/TextureAtlas.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ant
+{
+    TextureAtlas::TextureAtlas(const glm::ivec2 &pageSize, int32_t padding)
+        : m_pageSize(pageSize), m_padding(padding)
+    {
+    }
+
+    Ref<SubTexture> TextureAtlas::Add(const Ref<Texture> &texture)
+    {
+        CORE_ASSERT(texture->GetData(), "Atlas needs the local buffer of a texture!");
+
+        auto region = MakeRef<SubTexture>(texture);
+        m_entries.push_back({texture, region});
+        m_packed = false;
+        return region;
+    }
+
+    void TextureAtlas::Pack()
+    {
+        CORE_PROFILE_FUNC_CAT(Assets);
+        m_pages.clear();
+        m_stats = AtlasStats();
+
+        std::vector<glm::ivec2> sizes;
+        sizes.reserve(m_entries.size());
+        for (auto &entry : m_entries)
+            sizes.push_back(entry.source->GetSize());
+
+        auto layout = PackSkyline(sizes, m_pageSize, m_padding);
+        m_pages.resize(layout.pageCount);
+
+        for (auto &page : m_pages)
+            page.pixels.resize(size_t(m_pageSize.x) * m_pageSize.y * 4, 0);
+
+        for (size_t i = 0; i < m_entries.size(); i++)
+        {
+            auto &entry = m_entries[i];
+            auto size = entry.source->GetSize();
+            entry.page = layout.rects[i].page;
+            entry.position = layout.rects[i].position;
+
+            if (entry.page < 0)
+            {
+                CORE_WARN("Texture {0}x{1} does not fit into an atlas page", size.x, size.y);
+                m_stats.skippedCount++;
+                continue;
+            }
+
+            auto &pixels = m_pages[entry.page].pixels;
+            Blit(*entry.source, pixels, entry.position);
+            Extrude(pixels, entry.position, size);
+
+            m_stats.packedCount++;
+            m_stats.usedArea += uint64_t(size.x) * size.y;
+        }
+
+        m_stats.pageCount = m_pages.size();
+        m_stats.pageArea = uint64_t(m_pageSize.x) * m_pageSize.y * m_pages.size();
+        m_packed = true;
+
+        CORE_INFO("Atlas packed {0} textures into {1} pages, efficiency {2:.1f}%, skipped {3}",
+                  m_stats.packedCount, m_stats.pageCount, m_stats.GetEfficiency() * 100.f, m_stats.skippedCount);
+    }
+
+    void TextureAtlas::Build()
+    {
+        CORE_PROFILE_FUNC_CAT(Assets);
+        if (!m_packed)
+            Pack();
+
+        for (auto &page : m_pages)
+        {
+            //? texture takes ownership of the buffer and releases it with stbi_image_free (free)
+            size_t size = page.pixels.size();
+            uchar *data = (uchar *)malloc(size);
+            memcpy(data, page.pixels.data(), size);
+
+            page.texture = Texture::Create(m_pageSize, 4);
+            page.texture->SetData(data, size);
+        }
+
+        for (auto &entry : m_entries)
+        {
+            if (entry.page < 0)
+                continue;
+
+            auto size = entry.source->GetSize();
+            entry.region->SetTexture(m_pages[entry.page].texture);
+            entry.region->SetRegion({float(entry.position.x), float(entry.position.y), float(size.x), float(size.y)});
+        }
+    }
+
+    void TextureAtlas::Blit(const Texture &source, std::vector<uchar> &pixels, const glm::ivec2 &position)
+    {
+        auto size = source.GetSize();
+        uint32_t channels = source.GetChannelCount();
+        const uchar *src = source.GetData();
+        CORE_ASSERT(channels >= 1 && channels <= 4, "Atlas can not blit a texture with that many channels!");
+
+        //? rows keep the bottom-up order of the loaded image, so y is measured from the bottom like TextureRect
+        for (int32_t row = 0; row < size.y; row++)
+        {
+            uchar *dst = &pixels[(size_t(position.y + row) * m_pageSize.x + position.x) * 4];
+            const uchar *line = src + size_t(row) * size.x * channels;
+
+            if (channels == 4)
+            {
+                memcpy(dst, line, size_t(size.x) * 4);
+                continue;
+            }
+
+            //? stb channel layouts: grey, grey alpha, rgb
+            for (int32_t x = 0; x < size.x; x++)
+            {
+                const uchar *texel = line + x * channels;
+                bool grey = channels < 3;
+
+                dst[x * 4 + 0] = texel[0];
+                dst[x * 4 + 1] = grey ? texel[0] : texel[1];
+                dst[x * 4 + 2] = grey ? texel[0] : texel[2];
+                dst[x * 4 + 3] = channels == 2 ? texel[1] : 0xff;
+            }
+        }
+    }
+
+    void TextureAtlas::Extrude(std::vector<uchar> &pixels, const glm::ivec2 &position, const glm::ivec2 &size)
+    {
+        if (!m_padding)
+            return;
+
+        auto texel = [&](int32_t x, int32_t y)
+        { return &pixels[(size_t(y) * m_pageSize.x + x) * 4]; };
+
+        //? left and right edge columns first, then whole padded rows below and above, which also fills the corners
+        for (int32_t y = position.y; y < position.y + size.y; y++)
+        {
+            for (int32_t i = 1; i <= m_padding; i++)
+            {
+                memcpy(texel(position.x - i, y), texel(position.x, y), 4);
+                memcpy(texel(position.x + size.x - 1 + i, y), texel(position.x + size.x - 1, y), 4);
+            }
+        }
+
+        size_t rowBytes = size_t(size.x + 2 * m_padding) * 4;
+        int32_t left = position.x - m_padding;
+
+        for (int32_t i = 1; i <= m_padding; i++)
+        {
+            memcpy(texel(left, position.y - i), texel(left, position.y), rowBytes);
+            memcpy(texel(left, position.y + size.y - 1 + i), texel(left, position.y + size.y - 1), rowBytes);
+        }
+    }
+
+} // namespace ant
@@ -0,0 +1,71 @@
+#pragma once
+#include "Core/Core.hpp"
+#include "Graphics/Texture.hpp"
+#include "Graphics/SkylinePacker.hpp"
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace ant
+{
+
+    struct AtlasStats
+    {
+        uint32_t pageCount = 0;
+        uint32_t packedCount = 0;
+        uint32_t skippedCount = 0; // images bigger than a page, they keep their own texture
+        uint64_t usedArea = 0;     // pixels covered by images
+        uint64_t pageArea = 0;
+
+        float GetEfficiency() const { return pageArea ? float(usedArea) / float(pageArea) : 0.f; }
+    };
+
+    //? merges textures into shared RGBA8 pages so sprites stop competing for Renderer2D texture slots
+    //? the layout comes from PackSkyline, Pack() blits the images on the cpu, Build() creates the page textures
+    //? the padding repeats the edge texels of each image so bilinear sampling does not bleed in its neighbours
+    class TextureAtlas
+    {
+    public:
+        static Ref<TextureAtlas> Create(const glm::ivec2 &pageSize = {2048, 2048}, int32_t padding = 1) { return MakeRef<TextureAtlas>(pageSize, padding); }
+
+        TextureAtlas(const glm::ivec2 &pageSize, int32_t padding);
+        ~TextureAtlas() {}
+
+        //! texture must still have its local buffer (LoadFromFile or SetKeepLocalBuffer), 1 to 4 channels
+        Ref<SubTexture> Add(const Ref<Texture> &texture);
+
+        void Pack();
+        void Build();
+
+        inline const AtlasStats &GetStats() const { return m_stats; }
+        inline size_t GetPageCount() const { return m_pages.size(); }
+        inline const std::vector<uchar> &GetPageData(size_t page) const { return m_pages.at(page).pixels; }
+        inline const Ref<Texture> &GetPageTexture(size_t page) const { return m_pages.at(page).texture; }
+
+    private:
+        void Blit(const Texture &source, std::vector<uchar> &pixels, const glm::ivec2 &position);
+        void Extrude(std::vector<uchar> &pixels, const glm::ivec2 &position, const glm::ivec2 &size); // fills the padding around a blitted image
+
+    private:
+        struct Entry
+        {
+            Ref<Texture> source;
+            Ref<SubTexture> region;
+            int32_t page = -1;
+            glm::ivec2 position;
+        };
+
+        struct Page
+        {
+            std::vector<uchar> pixels;
+            Ref<Texture> texture;
+        };
+
+        glm::ivec2 m_pageSize;
+        int32_t m_padding;
+        std::vector<Entry> m_entries;
+        std::vector<Page> m_pages;
+        AtlasStats m_stats;
+        bool m_packed = false;
+    };
+
+} // namespace ant
@@ -50,14 +50,20 @@ namespace ant
         CalcVertexSize();
     }
 
-    void VertexBufferLayout::SetAttribPtrs()
+    void VertexBufferLayout::SetAttribPtrs(uint32_t divisor)
     {
-        CORE_PROFILE_FUNC();
-        uint32_t pointerVal = 0;
+        CORE_PROFILE_FUNC_CAT(Render);
+        uint64_t pointerVal = 0;
         for (size_t i = 0; i < m_layoutTypes.size(); i++)
         {
             auto &ref = m_layoutTypes.at(i);
-            glVertexAttribPointer(i, GetAttribTypeComponentCount(ref), GetAttribGlType(ref), GL_FALSE, m_vertexSize, (void *)pointerVal);
+
+            if (GetAttribGlType(ref) == GL_UNSIGNED_INT)
+                glVertexAttribIPointer(i, GetAttribTypeComponentCount(ref), GL_UNSIGNED_INT, m_vertexSize, (void *)pointerVal);
+            else
+                glVertexAttribPointer(i, GetAttribTypeComponentCount(ref), GetAttribGlType(ref), GL_FALSE, m_vertexSize, (void *)pointerVal);
+
+            glVertexAttribDivisor(i, divisor);
             glEnableVertexAttribArray(i);
             pointerVal += GetAttribTypeSize(ref);
         }
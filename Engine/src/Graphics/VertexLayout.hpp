@@ -31,7 +31,7 @@ namespace ant
 
         VertexBufferLayout(std::initializer_list<AttributeType> args);
 
-        void SetAttribPtrs();
+        void SetAttribPtrs(uint32_t divisor = 0); // divisor 1 makes attributes advance per instance
         void DisablePtrs();
 
         inline void PushAttribute(AttributeType attribute)
@@ -40,6 +40,8 @@ namespace ant
             CalcVertexSize();
         }
 
+        inline uint32_t GetStride() const { return m_vertexSize; }
+
     private:
         void CalcVertexSize();
 
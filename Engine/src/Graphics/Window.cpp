@@ -3,24 +3,51 @@
 #include <Gl.h>
 #include "debug/Instrumentation.hpp"
 #include "Render/RendererCommands.hpp"
+#include "Render/NullGl.hpp"
+#include "Input/EventQueue.hpp"
 
 namespace ant
 {
 
     Window::~Window()
     {
+        if (!m_nativeWindow)
+            return; // null backend, glfw never started
+
         glfwDestroyWindow(m_nativeWindow);
         RendererCommands::ShutdownGlfw();
     }
 
     void Window::Update()
     {
-        CORE_PROFILE_FUNC();
-        glfwPollEvents();
-        {
-            CORE_PROFILE_SCOPE("glfwSwapBuffers");
+        CORE_PROFILE_FUNC_CAT(Render);
+        PollEvents();
+        SwapBuffers();
+    }
+
+    void Window::PollEvents()
+    {
+        if (m_nativeWindow)
+            glfwPollEvents();
+    }
+
+    void Window::SwapBuffers()
+    {
+        CORE_PROFILE_SCOPE_CAT("glfwSwapBuffers", Render);
+        if (m_nativeWindow)
             glfwSwapBuffers(m_nativeWindow);
-        }
+    }
+
+    void Window::MakeContextCurrent()
+    {
+        if (m_nativeWindow)
+            glfwMakeContextCurrent(m_nativeWindow);
+    }
+
+    void Window::ReleaseContext()
+    {
+        if (m_nativeWindow)
+            glfwMakeContextCurrent(nullptr);
     }
 
     void Window::SetResizeability(bool resizeable)
@@ -36,7 +63,8 @@ namespace ant
     {
         m_properties.vsync = vsync;
 
-        glfwSwapInterval(int(vsync));
+        if (m_nativeWindow)
+            glfwSwapInterval(int(vsync));
     }
 
     void Window::SetWindowSize(int width, int height)
@@ -47,19 +75,37 @@ namespace ant
 
     void Window::Init(const Properties &props)
     {
+        if (props.backend == RenderBackend::Null)
+        {
+            //? no events ever come, the app runs until something calls Application::Terminate
+            m_properties = props;
+            NullGl::Install();
+            return;
+        }
 
-        RendererCommands::InitGlfw();
+        RendererCommands::InitGlfw(props.backend);
 
         m_nativeWindow = glfwCreateWindow(props.width, props.height, props.title.c_str(), NULL, NULL);
 
+        if (m_nativeWindow == NULL && props.backend == RenderBackend::Offscreen)
+        {
+            //? no osmesa on the machine, a surfaceless egl context (mesa, or a gpu driver without a display) is the other way
+            CORE_WARN("No OSMesa context, trying EGL");
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+            m_nativeWindow = glfwCreateWindow(props.width, props.height, props.title.c_str(), NULL, NULL);
+        }
+
         if (m_nativeWindow == NULL)
         {
-            CORE_ASSERT(false, "Failed to create GLFW window");
-            glfwTerminate();
+            //? headless machines may have no gl at all, callers check IsOpen and skip
+            CORE_ASSERT(props.backend == RenderBackend::Offscreen, "Failed to create GLFW window");
+            CORE_ERROR("Failed to create an offscreen gl context");
+            RendererCommands::ShutdownGlfw();
+            return;
         }
 
         glfwMakeContextCurrent(m_nativeWindow);
-        RendererCommands::InitGlew();
+        RendererCommands::InitGlew(props.backend);
 
         SetVsync(props.vsync);
         SetResizeability(props.resizeable);
@@ -72,7 +118,6 @@ namespace ant
             glfwSetKeyCallback(m_nativeWindow, [](GLFWwindow *window, int key, int scancode, int action, int mods)
                                {
                                    auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                   auto EventCallback = windowPtr->GetEventCallback();
 
                                    KeyCode myKey = KeyCode(key);
                                    KeyModifier myMod = KeyModifier(mods);
@@ -81,20 +126,17 @@ namespace ant
                                    {
                                    case GLFW_PRESS:
                                    {
-                                       KeyPressedEvent e(myKey, myMod);
-                                       EventCallback(e);
+                                       windowPtr->m_eventQueue->Push(KeyPressedEvent(myKey, myMod));
                                        break;
                                    }
                                    case GLFW_RELEASE:
                                    {
-                                       KeyReleasedEvent e(myKey, myMod);
-                                       EventCallback(e);
+                                       windowPtr->m_eventQueue->Push(KeyReleasedEvent(myKey, myMod));
                                        break;
                                    }
                                    case GLFW_REPEAT:
                                    {
-                                       KeyPressedEvent e(myKey, myMod, true);
-                                       EventCallback(e);
+                                       windowPtr->m_eventQueue->Push(KeyPressedEvent(myKey, myMod, true));
                                        break;
                                    }
                                    default:
@@ -105,7 +147,6 @@ namespace ant
             glfwSetMouseButtonCallback(m_nativeWindow, [](GLFWwindow *window, int button, int action, int mods)
                                        {
                                            auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                           auto EventCallback = windowPtr->GetEventCallback();
 
                                            auto myButton = MouseButtonCode(button);
                                            KeyModifier myMod = KeyModifier(mods);
@@ -113,14 +154,12 @@ namespace ant
                                            {
                                            case GLFW_PRESS:
                                            {
-                                               MouseButtonPressedEvent e(myButton, myMod);
-                                               EventCallback(e);
+                                               windowPtr->m_eventQueue->Push(MouseButtonPressedEvent(myButton, myMod));
                                                break;
                                            }
                                            case GLFW_RELEASE:
                                            {
-                                               MouseButtonReleasedEvent e(myButton, myMod);
-                                               EventCallback(e);
+                                               windowPtr->m_eventQueue->Push(MouseButtonReleasedEvent(myButton, myMod));
                                                break;
                                            }
 
@@ -132,47 +171,35 @@ namespace ant
             glfwSetScrollCallback(m_nativeWindow, [](GLFWwindow *window, double xoffset, double yoffset)
                                   {
                                       auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                      auto EventCallback = windowPtr->GetEventCallback();
-
-                                      MouseScrolledEvent e({xoffset, yoffset});
-                                      EventCallback(e);
+                                      windowPtr->m_eventQueue->Push(MouseScrolledEvent({xoffset, yoffset}));
                                   });
 
             glfwSetCursorPosCallback(m_nativeWindow, [](GLFWwindow *window, double xpos, double ypos)
                                      {
                                          auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                         auto EventCallback = windowPtr->GetEventCallback();
-
-                                         MouseMovedEvent e({xpos, ypos});
-                                         EventCallback(e);
+                                         windowPtr->m_eventQueue->Push(MouseMovedEvent({xpos, ypos}));
                                      });
 
             glfwSetWindowCloseCallback(m_nativeWindow, [](GLFWwindow *window)
                                        {
                                            auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                           auto EventCallback = windowPtr->GetEventCallback();
-
-                                           WindowClosedEvent e;
-                                           EventCallback(e);
+                                           windowPtr->m_eventQueue->Push(WindowClosedEvent());
                                        });
 
             glfwSetWindowFocusCallback(m_nativeWindow, [](GLFWwindow *window, int iconified)
                                        {
                                            auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                           auto EventCallback = windowPtr->GetEventCallback();
 
                                            switch (iconified)
                                            {
                                            case GLFW_TRUE:
                                            {
-                                               WindowFocusedEvent e;
-                                               EventCallback(e);
+                                               windowPtr->m_eventQueue->Push(WindowFocusedEvent());
                                                break;
                                            }
                                            case GLFW_FALSE:
                                            {
-                                               WindowUnfocusedEvent e;
-                                               EventCallback(e);
+                                               windowPtr->m_eventQueue->Push(WindowUnfocusedEvent());
                                                break;
                                            }
                                            default:
@@ -183,12 +210,12 @@ namespace ant
             glfwSetWindowSizeCallback(m_nativeWindow, [](GLFWwindow *window, int width, int height)
                                       {
                                           auto *windowPtr = (Window *)glfwGetWindowUserPointer(window);
-                                          auto EventCallback = windowPtr->GetEventCallback();
 
-                                          WindowRezisedEvent e({width, height});
                                           windowPtr->SetWindowSize(width, height);
-                                          glViewport(0, 0, width, height);
-                                          EventCallback(e);
+                                          //? with a render thread the context lives there, Application resizes the viewport through the packet
+                                          if (glfwGetCurrentContext() == window)
+                                              glViewport(0, 0, width, height);
+                                          windowPtr->m_eventQueue->Push(WindowRezisedEvent({width, height}));
                                       });
         }
     }
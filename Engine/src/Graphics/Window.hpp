@@ -4,23 +4,23 @@
 #include <string>
 #include <functional>
 #include <glm/glm.hpp>
+#include "Render/RenderBackend.hpp"
 
 class GLFWwindow;
 
 namespace ant
 {
-    class Event;
+    class EventQueue;
     class Window
     {
     public:
-        using EventCallback = std::function<void(Event &)>;
-
         struct Properties
         {
             uint32_t width, height;
             std::string title;
             bool vsync = false;
             bool resizeable = true;
+            RenderBackend backend = RenderBackend::Native;
         };
 
     public:
@@ -28,12 +28,20 @@ namespace ant
         ~Window();
 
         void Init(const Properties &props);
-        void Update();
+        void Update(); // PollEvents + SwapBuffers
+        void PollEvents();
+        void SwapBuffers(); //! on the thread that holds the gl context
+
+        //? moves the gl context between threads, nothing to move with the null backend
+        void MakeContextCurrent();
+        void ReleaseContext();
 
-        void SetEventCallback(EventCallback callback) { m_eventCallback = callback; }
-        EventCallback GetEventCallback() const { return m_eventCallback; }
+        //? callbacks only push events, whoever owns the queue dispatches them
+        void SetEventQueue(EventQueue *queue) { m_eventQueue = queue; }
 
-        inline GLFWwindow *GetNativeWindow() const { return m_nativeWindow; }
+        inline GLFWwindow *GetNativeWindow() const { return m_nativeWindow; } // nullptr with the null backend
+        inline bool IsOpen() const { return m_nativeWindow || m_properties.backend == RenderBackend::Null; } // false when Init failed
+        inline RenderBackend GetBackend() const { return m_properties.backend; }
         inline glm::ivec2 GetSize() const { return {m_properties.width, m_properties.height}; }
 
         void SetResizeability(bool resizeable);
@@ -48,9 +56,9 @@ namespace ant
         void SetWindowSize(int width, int height);
 
     private: //member varibles
-        GLFWwindow *m_nativeWindow;
+        GLFWwindow *m_nativeWindow = nullptr;
         Properties m_properties;
-        EventCallback m_eventCallback;
+        EventQueue *m_eventQueue = nullptr;
     };
 
 } // namespace ant
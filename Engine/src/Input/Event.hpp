@@ -1,10 +1,8 @@
 #pragma once
 #include <stdint.h>
-#include <string>
-#include <functional>
-#include <vector>
-#include <typeinfo>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include "Input/KeyCodes.hpp"
 
 namespace ant
@@ -15,6 +13,7 @@ namespace ant
     using MouseOffsetType = double;
     using WindowSizeType = int32_t;
 
+    //? same order as the alternatives of EventData, the type is the variant index
     enum class EventType
     {
         None = 0,
@@ -39,73 +38,23 @@ namespace ant
         Window
     };
 
-#define SET_EVENT_TYPE(event_type)                                          \
-    virtual const char *GetLog() override { return "Event: " #event_type; } \
-    inline static EventType GetStaticType() { return EventType::event_type; }
+#define SET_EVENT_TYPE(event_type)                                         \
+    static constexpr EventType s_type = EventType::event_type;             \
+    inline static constexpr EventType GetStaticType() { return s_type; }   \
+    inline static constexpr const char *GetName() { return #event_type; }
 
-#define LOG_FUNC_OVERRIDE() virtual std::string GetStringLog() override;
-
-    class Event
-    {
-    public:
-        virtual ~Event() {}
-
-        virtual std::string GetStringLog() { return GetLog(); } // override manually
-        inline const EventType &GetEventType() { return m_type; }
-        virtual const char *GetLog() = 0;
-        void MarkHandled(bool state = true) { m_handled = state; }
-        friend class EventDispatcher;
-        friend class LayerStack;
-
-        EventCategory GetEventCategory();
-        bool IsInCategory(EventCategory category) { return GetEventCategory() == category; }
-
-    protected:
-        Event(EventType type) : m_type(type) {}
-
-        EventType m_type;
-        bool m_handled = false;
-    };
-
-    class EventDispatcher
-    {
-    public:
-        EventDispatcher() {}
-        EventDispatcher(Event &e) : m_event(&e) {}
-        ~EventDispatcher() {}
-
-        void SetEventPtr(Event *e) { m_event = e; }
-
-        template <class evType>
-        bool DispatchEvent(const std::function<void(evType &)> &handler) //?check these casts
-        {
-
-            if (evType::GetStaticType() == m_event->GetEventType())
-            {
-                handler(static_cast<evType &>(*m_event));
-                return true;
-            }
-            return false;
-        }
-
-    private:
-        Event *m_event;
-    };
+    //? events are plain data, trivially copyable and without virtual functions, Event holds any of them
 
     // KeyEvents
 
     class KeyEvent
-        : public Event
     {
     public:
-        virtual ~KeyEvent() {}
-
-        LOG_FUNC_OVERRIDE();
-        inline KeycodeType GetKeyCode() { return m_key; }
-        bool HasModifier(KeyModifier mod) const;
+        inline KeycodeType GetKeyCode() const { return m_key; }
+        inline bool HasModifier(KeyModifier mod) const { return int16_t(mod) & int16_t(m_modifier); }
 
     protected:
-        KeyEvent(KeycodeType key, KeyModifier modifier, EventType type) : Event(type), m_key(key), m_modifier(modifier) {}
+        KeyEvent(KeycodeType key, KeyModifier modifier) : m_key(key), m_modifier(modifier) {}
         KeycodeType m_key;
         KeyModifier m_modifier;
     };
@@ -114,11 +63,9 @@ namespace ant
         : public KeyEvent
     {
     public:
-        KeyPressedEvent(KeycodeType key, KeyModifier modifier, bool repeating = false) : KeyEvent(key, modifier, EventType::KeyPressed), m_repeating(repeating) {}
-        ~KeyPressedEvent() {}
+        KeyPressedEvent(KeycodeType key, KeyModifier modifier, bool repeating = false) : KeyEvent(key, modifier), m_repeating(repeating) {}
         SET_EVENT_TYPE(KeyPressed);
-        LOG_FUNC_OVERRIDE();
-        inline bool IsRepeating() { return m_repeating; }
+        inline bool IsRepeating() const { return m_repeating; }
 
     private:
         bool m_repeating;
@@ -128,25 +75,20 @@ namespace ant
         : public KeyEvent
     {
     public:
-        KeyReleasedEvent(KeycodeType key, KeyModifier modifier) : KeyEvent(key, modifier, EventType::KeyReleased) {}
-        ~KeyReleasedEvent() {}
-
+        KeyReleasedEvent(KeycodeType key, KeyModifier modifier) : KeyEvent(key, modifier) {}
         SET_EVENT_TYPE(KeyReleased);
     };
 
     //MouseEvents
 
     class MouseButtonEvent
-        : public Event
     {
     public:
-        virtual ~MouseButtonEvent() {}
-        inline ButtoncodeType GetButtonCode() { return m_button; }
-        bool HasModifier(KeyModifier mod) const;
-        LOG_FUNC_OVERRIDE();
+        inline ButtoncodeType GetButtonCode() const { return m_button; }
+        inline bool HasModifier(KeyModifier mod) const { return int16_t(mod) & int16_t(m_modifier); }
 
     protected:
-        MouseButtonEvent(EventType type, ButtoncodeType key, KeyModifier modifier) : Event(type), m_button(key), m_modifier(modifier) {}
+        MouseButtonEvent(ButtoncodeType key, KeyModifier modifier) : m_modifier(modifier), m_button(key) {}
 
         KeyModifier m_modifier;
         ButtoncodeType m_button;
@@ -156,10 +98,7 @@ namespace ant
         : public MouseButtonEvent
     {
     public:
-        MouseButtonPressedEvent(ButtoncodeType button, KeyModifier modifier)
-            : MouseButtonEvent(EventType::MouseButtonPressed, button, modifier) {}
-
-        ~MouseButtonPressedEvent() {}
+        MouseButtonPressedEvent(ButtoncodeType button, KeyModifier modifier) : MouseButtonEvent(button, modifier) {}
         SET_EVENT_TYPE(MouseButtonPressed);
     };
 
@@ -167,13 +106,11 @@ namespace ant
         : public MouseButtonEvent
     {
     public:
-        MouseButtonReleasedEvent(ButtoncodeType button, KeyModifier modifier) : MouseButtonEvent(EventType::MouseButtonReleased, button, modifier) {}
-        ~MouseButtonReleasedEvent() {}
+        MouseButtonReleasedEvent(ButtoncodeType button, KeyModifier modifier) : MouseButtonEvent(button, modifier) {}
         SET_EVENT_TYPE(MouseButtonReleased);
     };
 
     class MouseScrolledEvent
-        : public Event
     {
     public:
         struct ScrollData
@@ -182,18 +119,15 @@ namespace ant
         };
 
     public:
-        MouseScrolledEvent(const ScrollData &scrollData) : Event(EventType::MouseScrolled), m_scrollData(scrollData) {}
-        const ScrollData &GetScrollOffset() { return m_scrollData; }
-        ~MouseScrolledEvent() {}
+        MouseScrolledEvent(const ScrollData &scrollData) : m_scrollData(scrollData) {}
+        const ScrollData &GetScrollOffset() const { return m_scrollData; }
         SET_EVENT_TYPE(MouseScrolled);
-        LOG_FUNC_OVERRIDE();
 
     private:
         ScrollData m_scrollData;
     };
 
     class MouseMovedEvent
-        : public Event
     {
     public:
         struct MousePosData
@@ -202,11 +136,9 @@ namespace ant
         };
 
     public:
-        MouseMovedEvent(MousePosData pos) : Event(EventType::MouseMoved), m_position(pos) {}
-        ~MouseMovedEvent() {}
+        MouseMovedEvent(MousePosData pos) : m_position(pos) {}
         SET_EVENT_TYPE(MouseMoved);
-        LOG_FUNC_OVERRIDE();
-        inline const MousePosData &GetMousePos() { return m_position; }
+        inline const MousePosData &GetMousePos() const { return m_position; }
 
     private:
         MousePosData m_position;
@@ -215,7 +147,6 @@ namespace ant
     //WindowEvents
 
     class WindowRezisedEvent
-        : public Event
     {
     public:
         struct WindowSize
@@ -224,50 +155,128 @@ namespace ant
         };
 
     public:
-        WindowRezisedEvent(WindowSize size) : Event(EventType::WindowRezised), m_size(size) {}
-        ~WindowRezisedEvent() {}
+        WindowRezisedEvent(WindowSize size) : m_size(size) {}
         SET_EVENT_TYPE(WindowRezised);
-        inline const WindowSize &GetWindowSize() { return m_size; }
-        LOG_FUNC_OVERRIDE();
+        inline const WindowSize &GetWindowSize() const { return m_size; }
 
     private:
         WindowSize m_size;
     };
 
     class WindowMinimalizedEvent
-        : public Event
     {
     public:
-        WindowMinimalizedEvent() : Event(EventType::WindowMinimalized) {}
-        ~WindowMinimalizedEvent() {}
-        SET_EVENT_TYPE(WindowRezised);
+        SET_EVENT_TYPE(WindowMinimalized);
     };
 
     class WindowClosedEvent
-        : public Event
     {
     public:
-        WindowClosedEvent() : Event(EventType::WindowClosed) {}
-        ~WindowClosedEvent() {}
         SET_EVENT_TYPE(WindowClosed);
     };
 
     class WindowFocusedEvent
-        : public Event
     {
     public:
-        WindowFocusedEvent() : Event(EventType::WindowFocused) {}
-        ~WindowFocusedEvent() {}
         SET_EVENT_TYPE(WindowFocused);
     };
 
     class WindowUnfocusedEvent
-        : public Event
     {
     public:
-        WindowUnfocusedEvent() : Event(EventType::WindowUnfocused) {}
-        ~WindowUnfocusedEvent() {}
         SET_EVENT_TYPE(WindowUnfocused);
     };
 
+    using EventData = std::variant<std::monostate,
+                                   KeyPressedEvent, KeyReleasedEvent,
+                                   MouseButtonPressedEvent, MouseButtonReleasedEvent, MouseScrolledEvent, MouseMovedEvent,
+                                   WindowRezisedEvent, WindowMinimalizedEvent, WindowClosedEvent, WindowFocusedEvent, WindowUnfocusedEvent>;
+
+    //? overload set for Event::Visit, [](KeyPressedEvent &e) { ... } style handlers
+    template <class... Fns>
+    struct EventHandlers : Fns...
+    {
+        using Fns::operator()...;
+    };
+
+    template <class... Fns>
+    EventHandlers(Fns...) -> EventHandlers<Fns...>;
+
+    //? one of the events above plus the handled flag, trivially copyable, queued and passed around by value
+    class Event
+    {
+    public:
+        Event() {}
+        template <class T, class = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Event>>>
+        Event(const T &data) : m_data(data) {}
+
+        inline EventType GetEventType() const { return EventType(m_data.index()); }
+        inline EventCategory GetEventCategory() const { return GetCategory(GetEventType()); }
+        inline bool IsInCategory(EventCategory category) const { return GetEventCategory() == category; }
+        const char *GetName() const;
+
+        inline bool IsHandled() const { return m_handled; }
+        void MarkHandled(bool state = true) { m_handled = state; }
+
+        //? nullptr unless the event holds a T, a single index compare
+        template <class T>
+        inline T *As() { return std::get_if<T>(&m_data); }
+
+        //? calls the handler taking the held type through the jump table of std::visit, events without one are ignored
+        //? handlers inline, there is no std::function in between
+        template <class... Handlers>
+        void Visit(Handlers &&...handlers)
+        {
+            std::visit(EventHandlers{std::forward<Handlers>(handlers)..., [](const auto &) {}}, m_data);
+        }
+
+        static constexpr EventCategory GetCategory(EventType type)
+        {
+            if (type == EventType::None)
+                return EventCategory::None;
+
+            if (type <= EventType::KeyReleased)
+                return EventCategory::Keyboard;
+
+            if (type <= EventType::MouseMoved)
+                return EventCategory::Mouse;
+
+            return EventCategory::Window;
+        }
+
+    private:
+        EventData m_data;
+        bool m_handled = false;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Event>, "events have to stay plain data!");
+    static_assert(std::variant_size_v<EventData> == size_t(EventType::WindowUnfocused) + 1, "EventData has to follow EventType!");
+    static_assert(std::is_same_v<std::variant_alternative_t<size_t(EventType::MouseMoved), EventData>, MouseMovedEvent>, "EventData has to follow EventType!");
+    static_assert(std::is_same_v<std::variant_alternative_t<size_t(EventType::WindowUnfocused), EventData>, WindowUnfocusedEvent>, "EventData has to follow EventType!");
+
+    class EventDispatcher
+    {
+    public:
+        EventDispatcher() {}
+        EventDispatcher(Event &e) : m_event(&e) {}
+        ~EventDispatcher() {}
+
+        void SetEventPtr(Event *e) { m_event = e; }
+
+        //? handler(evType &) is a template parameter, it inlines into the type check
+        template <class evType, class Fn>
+        bool DispatchEvent(Fn &&handler)
+        {
+            if (evType *event = m_event->As<evType>())
+            {
+                handler(*event);
+                return true;
+            }
+            return false;
+        }
+
+    private:
+        Event *m_event;
+    };
+
 } // namespace ant
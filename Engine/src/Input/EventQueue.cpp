@@ -0,0 +1,93 @@
+#include "Pch.h"
+#include "Input/EventQueue.hpp"
+#include "debug/Metrics.hpp"
+#include <bit>
+
+namespace ant
+{
+    EventQueue::EventQueue(uint32_t capacity)
+        : m_cells(std::bit_ceil(capacity)), m_mask(std::bit_ceil(capacity) - 1)
+    {
+        for (uint32_t i = 0; i < m_cells.size(); i++)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+
+        m_drained.reserve(m_cells.size());
+    }
+
+    bool EventQueue::Push(const Event &event)
+    {
+        uint32_t position = m_tail.load(std::memory_order_relaxed);
+        Cell *cell;
+
+        while (true)
+        {
+            cell = &m_cells[position & m_mask];
+            uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+            int32_t difference = int32_t(sequence - position);
+
+            if (!difference)
+            {
+                //? the cell is free for this lap, claim it
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed); // the consumer hasn't freed it yet
+                return false;
+            }
+            else
+                position = m_tail.load(std::memory_order_relaxed); // another producer took it
+        }
+
+        cell->event = event;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool EventQueue::Pop(Event &event)
+    {
+        Cell &cell = m_cells[m_head & m_mask];
+
+        if (cell.sequence.load(std::memory_order_acquire) != m_head + 1)
+            return false;
+
+        event = cell.event;
+        cell.sequence.store(m_head + m_mask + 1, std::memory_order_release); // free for the next lap
+        m_head++;
+        return true;
+    }
+
+    bool EventQueue::IsCoalesced(const Event &event, const Event &next)
+    {
+        //? both carry absolute values, the later one of a run is all the layers need
+        EventType type = event.GetEventType();
+        return type == next.GetEventType() && (type == EventType::MouseMoved || type == EventType::WindowRezised);
+    }
+
+    void EventQueue::PublishMetrics(uint64_t dispatched, uint64_t coalesced)
+    {
+        static auto &dispatchedCounter = Metrics::GetCounter("events.dispatched");
+        static auto &coalescedCounter = Metrics::GetCounter("events.coalesced");
+        static auto &droppedCounter = Metrics::GetCounter("events.dropped");
+
+        uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+
+        dispatchedCounter.Add(dispatched);
+        coalescedCounter.Add(coalesced);
+        droppedCounter.Add(dropped - m_droppedPublished);
+        m_droppedPublished = dropped;
+    }
+
+    EventQueue::Stats EventQueue::GetStats() const
+    {
+        Stats stats;
+        stats.pushed = m_pushed.load(std::memory_order_relaxed);
+        stats.dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.dispatched = m_dispatched;
+        stats.coalesced = m_coalesced;
+        return stats;
+    }
+
+} // namespace ant
@@ -0,0 +1,90 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include "Input/Event.hpp"
+#include "debug/Instrumentation.hpp"
+
+namespace ant
+{
+    //? bounded lock-free queue of events by value, any thread pushes, one thread drains it once per frame
+    //? cells carry a sequence number like Vyukov's bounded queue, producers only race on the tail
+    class EventQueue
+    {
+    public:
+        struct Stats
+        {
+            uint64_t pushed = 0;
+            uint64_t dispatched = 0;
+            uint64_t coalesced = 0; // mouse moves and resizes replaced by a later one of the same frame
+            uint64_t dropped = 0;   // pushed into a full queue
+        };
+
+        EventQueue(uint32_t capacity = 1024);
+
+        EventQueue(const EventQueue &) = delete;
+        EventQueue &operator=(const EventQueue &) = delete;
+
+        bool Push(const Event &event); // false when full, the event is dropped
+
+        //? fn(Event &) for every event pushed before the call, events pushed by fn wait for the next drain
+        //? consecutive MouseMovedEvents and WindowRezisedEvents only dispatch the last one
+        //! from the consumer thread only
+        template <class Fn>
+        void Drain(Fn &&fn);
+
+        Stats GetStats() const;
+
+    private:
+        bool Pop(Event &event);
+        static bool IsCoalesced(const Event &event, const Event &next);
+        void PublishMetrics(uint64_t dispatched, uint64_t coalesced); // the counts of one Drain
+
+    private:
+        struct Cell
+        {
+            std::atomic<uint32_t> sequence;
+            Event event;
+        };
+
+        std::vector<Cell> m_cells;
+        uint32_t m_mask;
+        alignas(64) std::atomic<uint32_t> m_tail = 0; // producers
+        alignas(64) uint32_t m_head = 0;              // consumer
+        std::vector<Event> m_drained;                // reserved for the whole queue, reused every frame
+
+        std::atomic<uint64_t> m_pushed = 0;
+        std::atomic<uint64_t> m_dropped = 0;
+        uint64_t m_dispatched = 0;
+        uint64_t m_coalesced = 0;
+        uint64_t m_droppedPublished = 0; // consumer
+    };
+
+    template <class Fn>
+    void EventQueue::Drain(Fn &&fn)
+    {
+        CORE_PROFILE_FUNC_CAT(Events);
+        uint64_t dispatched = m_dispatched;
+        uint64_t coalesced = m_coalesced;
+        m_drained.clear();
+
+        Event event;
+        while (Pop(event))
+            m_drained.push_back(event);
+
+        for (size_t i = 0; i < m_drained.size(); i++)
+        {
+            if (i + 1 < m_drained.size() && IsCoalesced(m_drained[i], m_drained[i + 1]))
+            {
+                m_coalesced++;
+                continue;
+            }
+
+            fn(m_drained[i]);
+            m_dispatched++;
+        }
+
+        PublishMetrics(m_dispatched - dispatched, m_coalesced - coalesced);
+    }
+
+} // namespace ant
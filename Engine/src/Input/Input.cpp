@@ -15,14 +15,15 @@ namespace ant
 
     glm::vec2 Input::MousePos()
     {
-        double x, y;
-        glfwGetCursorPos(s_activeWindow->m_nativeWindow, &x, &y);
+        double x = 0.0, y = 0.0;
+        if (s_activeWindow->m_nativeWindow) // the null backend has no window to ask
+            glfwGetCursorPos(s_activeWindow->m_nativeWindow, &x, &y);
         return {x, y};
     }
 
     glm::vec2 Input::MouseWorldPos(const OrthographicCamera &camera)
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Events);
         auto mpos = MousePos();
         auto x = mpos.x, y = mpos.y;
 
@@ -46,6 +47,9 @@ namespace ant
 
     bool Input::IsKeyPressed(KeyCode key)
     {
+        if (!s_activeWindow->m_nativeWindow)
+            return false;
+
         auto state = glfwGetKey(s_activeWindow->m_nativeWindow, (int)key);
 
         switch (state)
@@ -67,6 +71,9 @@ namespace ant
 
     bool Input::IsMouseButtonPressed(MouseButtonCode buttonCode)
     {
+        if (!s_activeWindow->m_nativeWindow)
+            return false;
+
         auto state = glfwGetMouseButton(s_activeWindow->m_nativeWindow, (int)buttonCode);
 
         switch (state)
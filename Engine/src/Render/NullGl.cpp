@@ -0,0 +1,473 @@
+#include "Pch.h"
+#include "Render/NullGl.hpp"
+#include <Gl.h>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+
+namespace ant
+{
+    bool NullGl::s_installed = false;
+
+    namespace
+    {
+        enum class Command : uint32_t
+        {
+#define ANT_NULL_COMMAND(Name) Name,
+            ANT_GL11_ENTRY_POINTS(ANT_NULL_COMMAND)
+            ANT_GLEW_ENTRY_POINTS(ANT_NULL_COMMAND)
+#undef ANT_NULL_COMMAND
+            Count
+        };
+
+        constexpr const char *s_commandNames[] = {
+#define ANT_NULL_COMMAND_NAME(Name) "gl" #Name,
+            ANT_GL11_ENTRY_POINTS(ANT_NULL_COMMAND_NAME)
+            ANT_GLEW_ENTRY_POINTS(ANT_NULL_COMMAND_NAME)
+#undef ANT_NULL_COMMAND_NAME
+        };
+
+        //? relaxed, the render thread makes the calls and anyone may read the stats
+        struct Counters
+        {
+            std::atomic<uint64_t> drawCalls = 0;
+            std::atomic<uint64_t> vertices = 0;
+            std::atomic<uint64_t> dispatches = 0;
+            std::atomic<uint64_t> bytesUploaded = 0;
+            std::atomic<uint64_t> bytesAllocated = 0;
+            std::atomic<uint64_t> bytesMapped = 0;
+            std::atomic<uint64_t> bytesRead = 0;
+            std::atomic<uint64_t> commands[size_t(Command::Count)] = {};
+        } s_counters;
+
+        std::atomic<GLuint> s_nextId = 1; // 0 is no object for every gl object type
+
+        std::mutex s_buffersMutex;
+        std::unordered_map<GLuint, std::vector<uint8_t>> s_buffers; // node based, mapped pointers survive a rehash
+
+        inline void Count(Command command)
+        {
+            s_counters.commands[uint32_t(command)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline void Add(std::atomic<uint64_t> &counter, uint64_t value)
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        //? every entry point without a stub of its own, returns zero of whatever it returns
+        template <Command C, class Fn>
+        struct Stub;
+
+        template <Command C, class R, class... Args>
+        struct Stub<C, R(GLAPIENTRY *)(Args...)>
+        {
+            static R GLAPIENTRY Call(Args...)
+            {
+                Count(C);
+                if constexpr (!std::is_void_v<R>)
+                    return R{};
+            }
+        };
+
+        void GenerateIds(GLsizei n, GLuint *ids)
+        {
+            for (GLsizei i = 0; i < n; i++)
+                ids[i] = s_nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::vector<uint8_t> *FindBuffer(GLuint buffer)
+        {
+            auto it = s_buffers.find(buffer);
+            return it == s_buffers.end() ? nullptr : &it->second;
+        }
+
+        uint64_t GetTexelSize(GLenum internalFormat)
+        {
+            switch (internalFormat)
+            {
+            case GL_R8:
+                return 1;
+            case GL_RG8:
+                return 2;
+            case GL_RGB8:
+                return 3;
+            case GL_RGBA32F:
+                return 16;
+            default:
+                return 4; // GL_RGBA8, GL_DEPTH24_STENCIL8 and the rest of the 32 bit formats
+            }
+        }
+
+        uint64_t GetPixelSize(GLenum format, GLenum type)
+        {
+            uint64_t components = format == GL_RED ? 1 : format == GL_RG ? 2 : format == GL_RGB ? 3 : 4;
+            return components * (type == GL_FLOAT ? 4 : 1);
+        }
+
+        uint64_t GetStorageSize(GLsizei levels, GLenum internalFormat, uint64_t width, uint64_t height, uint64_t depth)
+        {
+            uint64_t bytes = 0;
+
+            for (GLsizei level = 0; level < levels; level++)
+            {
+                bytes += std::max<uint64_t>(width >> level, 1) * std::max<uint64_t>(height >> level, 1) * depth;
+            }
+
+            return bytes * GetTexelSize(internalFormat);
+        }
+
+        const GLubyte *GLAPIENTRY GetString(GLenum name)
+        {
+            Count(Command::GetString);
+            switch (name)
+            {
+            case GL_VERSION:
+                return (const GLubyte *)"4.5 Null";
+            case GL_SHADING_LANGUAGE_VERSION:
+                return (const GLubyte *)"4.50";
+            default:
+                return (const GLubyte *)"ant NullGl";
+            }
+        }
+
+        //? what a common desktop driver reports, the renderer sizes its batches and texture arrays from these
+        void GLAPIENTRY GetIntegerv(GLenum name, GLint *data)
+        {
+            Count(Command::GetIntegerv);
+            switch (name)
+            {
+            case GL_MAX_ARRAY_TEXTURE_LAYERS:
+                *data = 2048;
+                break;
+            case GL_MAX_TEXTURE_SIZE:
+                *data = 16384;
+                break;
+            case GL_MAX_TEXTURE_IMAGE_UNITS:
+            case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+                *data = 32;
+                break;
+            case GL_MAJOR_VERSION:
+                *data = 4;
+                break;
+            case GL_MINOR_VERSION:
+                *data = 5;
+                break;
+            default:
+                *data = 0;
+                break;
+            }
+        }
+
+        void GLAPIENTRY GetInteger64v(GLenum name, GLint64 *data)
+        {
+            Count(Command::GetInteger64v);
+            *data = name == GL_MAX_ELEMENT_INDEX ? GLint64(UINT32_MAX) : 0;
+        }
+
+        void GLAPIENTRY DrawElements(GLenum, GLsizei count, GLenum, const void *)
+        {
+            Count(Command::DrawElements);
+            Add(s_counters.drawCalls, 1);
+            Add(s_counters.vertices, count);
+        }
+
+        void GLAPIENTRY DrawElementsBaseVertex(GLenum, GLsizei count, GLenum, const void *, GLint)
+        {
+            Count(Command::DrawElementsBaseVertex);
+            Add(s_counters.drawCalls, 1);
+            Add(s_counters.vertices, count);
+        }
+
+        void GLAPIENTRY DrawArraysInstancedBaseInstance(GLenum, GLint, GLsizei count, GLsizei instances, GLuint)
+        {
+            Count(Command::DrawArraysInstancedBaseInstance);
+            Add(s_counters.drawCalls, 1);
+            Add(s_counters.vertices, uint64_t(count) * instances);
+        }
+
+        void GLAPIENTRY DrawArraysIndirect(GLenum, const void *)
+        {
+            Count(Command::DrawArraysIndirect);
+            Add(s_counters.drawCalls, 1); // the counts live in a buffer no compute shader wrote
+        }
+
+        void GLAPIENTRY DispatchCompute(GLuint, GLuint, GLuint)
+        {
+            Count(Command::DispatchCompute);
+            Add(s_counters.dispatches, 1);
+        }
+
+        void GLAPIENTRY CreateBuffers(GLsizei n, GLuint *buffers)
+        {
+            Count(Command::CreateBuffers);
+            GenerateIds(n, buffers);
+        }
+
+        void GLAPIENTRY CreateTextures(GLenum, GLsizei n, GLuint *textures)
+        {
+            Count(Command::CreateTextures);
+            GenerateIds(n, textures);
+        }
+
+        void GLAPIENTRY CreateVertexArrays(GLsizei n, GLuint *arrays)
+        {
+            Count(Command::CreateVertexArrays);
+            GenerateIds(n, arrays);
+        }
+
+        void GLAPIENTRY GenVertexArrays(GLsizei n, GLuint *arrays)
+        {
+            Count(Command::GenVertexArrays);
+            GenerateIds(n, arrays);
+        }
+
+        void GLAPIENTRY GenFramebuffers(GLsizei n, GLuint *framebuffers)
+        {
+            Count(Command::GenFramebuffers);
+            GenerateIds(n, framebuffers);
+        }
+
+        GLuint GLAPIENTRY CreateShader(GLenum)
+        {
+            Count(Command::CreateShader);
+            return s_nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        GLuint GLAPIENTRY CreateProgram()
+        {
+            Count(Command::CreateProgram);
+            return s_nextId.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        GLuint64 GLAPIENTRY GetTextureHandleARB(GLuint texture)
+        {
+            Count(Command::GetTextureHandleARB);
+            return texture;
+        }
+
+        void GLAPIENTRY GetShaderiv(GLuint, GLenum name, GLint *value)
+        {
+            Count(Command::GetShaderiv);
+            *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0; // no info log either
+        }
+
+        GLenum GLAPIENTRY CheckFramebufferStatus(GLenum)
+        {
+            Count(Command::CheckFramebufferStatus);
+            return GL_FRAMEBUFFER_COMPLETE;
+        }
+
+        GLsync GLAPIENTRY FenceSync(GLenum, GLbitfield)
+        {
+            Count(Command::FenceSync);
+            return GLsync(uintptr_t(s_nextId.fetch_add(1, std::memory_order_relaxed)));
+        }
+
+        GLenum GLAPIENTRY ClientWaitSync(GLsync, GLbitfield, GLuint64)
+        {
+            Count(Command::ClientWaitSync);
+            return GL_ALREADY_SIGNALED;
+        }
+
+        void GLAPIENTRY DeleteBuffers(GLsizei n, const GLuint *buffers)
+        {
+            Count(Command::DeleteBuffers);
+            std::lock_guard lock(s_buffersMutex);
+            for (GLsizei i = 0; i < n; i++)
+                s_buffers.erase(buffers[i]);
+        }
+
+        void GLAPIENTRY NamedBufferStorage(GLuint buffer, GLsizeiptr size, const void *data, GLbitfield)
+        {
+            Count(Command::NamedBufferStorage);
+            Add(s_counters.bytesAllocated, size);
+
+            std::lock_guard lock(s_buffersMutex);
+            auto &storage = s_buffers[buffer];
+            storage.assign(size, 0);
+
+            if (data)
+            {
+                std::memcpy(storage.data(), data, size);
+                Add(s_counters.bytesUploaded, size);
+            }
+        }
+
+        void GLAPIENTRY NamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data)
+        {
+            Count(Command::NamedBufferSubData);
+            Add(s_counters.bytesUploaded, size);
+
+            std::lock_guard lock(s_buffersMutex);
+            auto *storage = FindBuffer(buffer);
+            CORE_ASSERT(storage && size_t(offset + size) <= storage->size(), "NullGl: buffer update out of range!");
+            std::memcpy(storage->data() + offset, data, size);
+        }
+
+        void GLAPIENTRY GetNamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, void *data)
+        {
+            Count(Command::GetNamedBufferSubData);
+            Add(s_counters.bytesRead, size);
+
+            std::lock_guard lock(s_buffersMutex);
+            auto *storage = FindBuffer(buffer);
+            CORE_ASSERT(storage && size_t(offset + size) <= storage->size(), "NullGl: buffer read out of range!");
+            std::memcpy(data, storage->data() + offset, size);
+        }
+
+        void *GLAPIENTRY MapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield)
+        {
+            Count(Command::MapNamedBufferRange);
+            Add(s_counters.bytesMapped, length);
+
+            std::lock_guard lock(s_buffersMutex);
+            auto *storage = FindBuffer(buffer);
+            CORE_ASSERT(storage && size_t(offset + length) <= storage->size(), "NullGl: mapped range out of the buffer!");
+            return storage->data() + offset;
+        }
+
+        GLboolean GLAPIENTRY UnmapNamedBuffer(GLuint)
+        {
+            Count(Command::UnmapNamedBuffer);
+            return GL_TRUE;
+        }
+
+        //? the legacy bind to edit path, only sizes are kept
+        void GLAPIENTRY BufferData(GLenum, GLsizeiptr size, const void *data, GLenum)
+        {
+            Count(Command::BufferData);
+            Add(s_counters.bytesAllocated, size);
+            if (data)
+                Add(s_counters.bytesUploaded, size);
+        }
+
+        void GLAPIENTRY TextureStorage2D(GLuint, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height)
+        {
+            Count(Command::TextureStorage2D);
+            Add(s_counters.bytesAllocated, GetStorageSize(levels, internalFormat, width, height, 1));
+        }
+
+        void GLAPIENTRY TextureStorage3D(GLuint, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height, GLsizei depth)
+        {
+            Count(Command::TextureStorage3D);
+            Add(s_counters.bytesAllocated, GetStorageSize(levels, internalFormat, width, height, depth));
+        }
+
+        void GLAPIENTRY TextureSubImage2D(GLuint, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *)
+        {
+            Count(Command::TextureSubImage2D);
+            Add(s_counters.bytesUploaded, uint64_t(width) * height * GetPixelSize(format, type));
+        }
+
+        //? textures keep no storage, reads come back black
+        void GLAPIENTRY GetTextureImage(GLuint, GLint, GLenum, GLenum, GLsizei size, void *pixels)
+        {
+            Count(Command::GetTextureImage);
+            Add(s_counters.bytesRead, size);
+            std::memset(pixels, 0, size);
+        }
+    } // namespace
+
+    void NullGl::Install()
+    {
+        if (s_installed)
+            return;
+
+#define ANT_NULL_GL11(Name) gl::Name = &Stub<Command::Name, decltype(gl::Name)>::Call;
+#define ANT_NULL_GLEW(Name) __glew##Name = &Stub<Command::Name, decltype(__glew##Name)>::Call;
+        ANT_GL11_ENTRY_POINTS(ANT_NULL_GL11)
+        ANT_GLEW_ENTRY_POINTS(ANT_NULL_GLEW)
+#undef ANT_NULL_GL11
+#undef ANT_NULL_GLEW
+
+        gl::GetString = &GetString;
+        gl::GetIntegerv = &GetIntegerv;
+        gl::DrawElements = &DrawElements;
+
+        __glewGetInteger64v = &GetInteger64v;
+        __glewDrawElementsBaseVertex = &DrawElementsBaseVertex;
+        __glewDrawArraysInstancedBaseInstance = &DrawArraysInstancedBaseInstance;
+        __glewDrawArraysIndirect = &DrawArraysIndirect;
+        __glewDispatchCompute = &DispatchCompute;
+        __glewCreateBuffers = &CreateBuffers;
+        __glewCreateTextures = &CreateTextures;
+        __glewCreateVertexArrays = &CreateVertexArrays;
+        __glewGenVertexArrays = &GenVertexArrays;
+        __glewGenFramebuffers = &GenFramebuffers;
+        __glewCreateShader = &CreateShader;
+        __glewCreateProgram = &CreateProgram;
+        __glewGetTextureHandleARB = &GetTextureHandleARB;
+        __glewGetShaderiv = &GetShaderiv;
+        __glewCheckFramebufferStatus = &CheckFramebufferStatus;
+        __glewFenceSync = &FenceSync;
+        __glewClientWaitSync = &ClientWaitSync;
+        __glewDeleteBuffers = &DeleteBuffers;
+        __glewNamedBufferStorage = &NamedBufferStorage;
+        __glewNamedBufferSubData = &NamedBufferSubData;
+        __glewGetNamedBufferSubData = &GetNamedBufferSubData;
+        __glewMapNamedBufferRange = &MapNamedBufferRange;
+        __glewUnmapNamedBuffer = &UnmapNamedBuffer;
+        __glewBufferData = &BufferData;
+        __glewTextureStorage2D = &TextureStorage2D;
+        __glewTextureStorage3D = &TextureStorage3D;
+        __glewTextureSubImage2D = &TextureSubImage2D;
+        __glewGetTextureImage = &GetTextureImage;
+
+        //? what glewInit would have found on a 4.5 driver, bindless stays off so the renderer takes the texture array path
+        __GLEW_VERSION_1_1 = __GLEW_VERSION_1_2 = __GLEW_VERSION_1_3 = __GLEW_VERSION_1_4 = __GLEW_VERSION_1_5 = GL_TRUE;
+        __GLEW_VERSION_2_0 = __GLEW_VERSION_2_1 = __GLEW_VERSION_3_0 = __GLEW_VERSION_3_1 = __GLEW_VERSION_3_2 = GL_TRUE;
+        __GLEW_VERSION_3_3 = __GLEW_VERSION_4_0 = __GLEW_VERSION_4_1 = __GLEW_VERSION_4_2 = __GLEW_VERSION_4_3 = GL_TRUE;
+        __GLEW_VERSION_4_4 = __GLEW_VERSION_4_5 = GL_TRUE;
+
+        s_installed = true;
+        CORE_INFO("Null gl backend installed, nothing will be drawn");
+    }
+
+    NullGl::Stats NullGl::GetStats()
+    {
+        Stats stats;
+
+        for (auto &calls : s_counters.commands)
+            stats.calls += calls.load(std::memory_order_relaxed);
+
+        stats.drawCalls = s_counters.drawCalls.load(std::memory_order_relaxed);
+        stats.vertices = s_counters.vertices.load(std::memory_order_relaxed);
+        stats.dispatches = s_counters.dispatches.load(std::memory_order_relaxed);
+        stats.bytesUploaded = s_counters.bytesUploaded.load(std::memory_order_relaxed);
+        stats.bytesAllocated = s_counters.bytesAllocated.load(std::memory_order_relaxed);
+        stats.bytesMapped = s_counters.bytesMapped.load(std::memory_order_relaxed);
+        stats.bytesRead = s_counters.bytesRead.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void NullGl::ResetStats()
+    {
+        for (auto &calls : s_counters.commands)
+            calls.store(0, std::memory_order_relaxed);
+
+        for (auto *counter : {&s_counters.drawCalls, &s_counters.vertices, &s_counters.dispatches, &s_counters.bytesUploaded,
+                              &s_counters.bytesAllocated, &s_counters.bytesMapped, &s_counters.bytesRead})
+            counter->store(0, std::memory_order_relaxed);
+    }
+
+    uint32_t NullGl::GetCommandCount()
+    {
+        return uint32_t(Command::Count);
+    }
+
+    const char *NullGl::GetCommandName(uint32_t command)
+    {
+        return s_commandNames[command];
+    }
+
+    uint64_t NullGl::GetCommandCalls(uint32_t command)
+    {
+        return s_counters.commands[command].load(std::memory_order_relaxed);
+    }
+
+} // namespace ant
@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+
+namespace ant
+{
+    //? stands in for the driver, every gl entry point of Gl.h lands in a stub that counts the call and draws nothing
+    //? ids are handed out like a driver would, buffer storage lives in host memory so maps and read backs see what was uploaded
+    //? fences are always signaled and shaders always compile, the cpu side of a frame runs exactly as with a gpu
+    class NullGl
+    {
+    public:
+        struct Stats
+        {
+            uint64_t calls = 0;
+            uint64_t drawCalls = 0;
+            uint64_t vertices = 0; // indices of indexed draws, count times instances otherwise, indirect draws add none
+            uint64_t dispatches = 0;
+            uint64_t bytesUploaded = 0;  // buffer and texture data handed to gl
+            uint64_t bytesAllocated = 0; // buffer and texture storage
+            uint64_t bytesMapped = 0;    // persistently mapped ranges, written without a gl call
+            uint64_t bytesRead = 0;      // buffer and texture read backs
+        };
+
+        //! before the first gl call, replaces the entry points for the rest of the process
+        static void Install();
+        static inline bool IsInstalled() { return s_installed; }
+
+        static Stats GetStats();
+        static void ResetStats(); // between benchmark runs
+
+        //? calls of every entry point since the last ResetStats, fn(const char *name, uint64_t calls)
+        template <class Fn>
+        static void ForEachCommand(Fn &&fn)
+        {
+            for (uint32_t i = 0; i < GetCommandCount(); i++)
+                fn(GetCommandName(i), GetCommandCalls(i));
+        }
+
+    private:
+        NullGl() {}
+        ~NullGl() {}
+
+        static uint32_t GetCommandCount();
+        static const char *GetCommandName(uint32_t command);
+        static uint64_t GetCommandCalls(uint32_t command);
+
+    private:
+        static bool s_installed;
+    };
+
+} // namespace ant
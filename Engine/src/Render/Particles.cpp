@@ -1,92 +1,253 @@
 #include "Pch.h"
-#ifdef PARTICLES
 #include "Render/Particles.hpp"
 #include "Render/Renderer.hpp"
 #include "Core/Random.hpp"
+#include "Core/Cpu.hpp"
+#include "Core/JobSystem.hpp"
 #include "debug/Instrumentation.hpp"
-#include <glm/gtc/constants.hpp>
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/compatibility.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cmath>
 
 namespace ant
 {
-    Particle::Particle(const ParticleProps &props)
-        : m_props(props)
+    namespace
     {
-        m_lifeRemaining = m_props.lifeTime;
-    }
-
-    void Particle::OnUpdate()
-    {
-        CORE_PROFILE_FUNC();
-        if (!m_active)
-            return;
+        //? position += velocity * dt, rotation += rotationVelocity * dt, life -= dt
+        [[maybe_unused]] void UpdateScalar(ParticleArrays &p, uint32_t count, float dt)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                p.x[i] += p.velocityX[i] * dt;
+                p.y[i] += p.velocityY[i] * dt;
+                p.rotation[i] += p.rotationVelocity[i] * dt;
+                p.life[i] -= dt;
+            }
+        }
 
-        m_lifeRemaining -= TimeStep::GetFrameTime().Seconds();
+#ifdef ANT_X86_SIMD
+        void UpdateSse2(ParticleArrays &p, uint32_t count, float dt)
+        {
+            __m128 step = _mm_set1_ps(dt);
+            uint32_t i = 0;
+
+            //? vectors only guarantee 16 byte alignment through the allocator, loads stay unaligned
+            for (; i + 4 <= count; i += 4)
+            {
+                _mm_storeu_ps(&p.x[i], _mm_add_ps(_mm_loadu_ps(&p.x[i]), _mm_mul_ps(_mm_loadu_ps(&p.velocityX[i]), step)));
+                _mm_storeu_ps(&p.y[i], _mm_add_ps(_mm_loadu_ps(&p.y[i]), _mm_mul_ps(_mm_loadu_ps(&p.velocityY[i]), step)));
+                _mm_storeu_ps(&p.rotation[i], _mm_add_ps(_mm_loadu_ps(&p.rotation[i]), _mm_mul_ps(_mm_loadu_ps(&p.rotationVelocity[i]), step)));
+                _mm_storeu_ps(&p.life[i], _mm_sub_ps(_mm_loadu_ps(&p.life[i]), step));
+            }
+
+            for (; i < count; i++)
+            {
+                p.x[i] += p.velocityX[i] * dt;
+                p.y[i] += p.velocityY[i] * dt;
+                p.rotation[i] += p.rotationVelocity[i] * dt;
+                p.life[i] -= dt;
+            }
+        }
 
-        if (m_lifeRemaining <= 0)
+        ANT_TARGET_AVX2 void UpdateAvx2(ParticleArrays &p, uint32_t count, float dt)
         {
-            m_active = false;
-            return;
+            __m256 step = _mm256_set1_ps(dt);
+            uint32_t i = 0;
+
+            for (; i + 8 <= count; i += 8)
+            {
+                _mm256_storeu_ps(&p.x[i], _mm256_fmadd_ps(_mm256_loadu_ps(&p.velocityX[i]), step, _mm256_loadu_ps(&p.x[i])));
+                _mm256_storeu_ps(&p.y[i], _mm256_fmadd_ps(_mm256_loadu_ps(&p.velocityY[i]), step, _mm256_loadu_ps(&p.y[i])));
+                _mm256_storeu_ps(&p.rotation[i], _mm256_fmadd_ps(_mm256_loadu_ps(&p.rotationVelocity[i]), step, _mm256_loadu_ps(&p.rotation[i])));
+                _mm256_storeu_ps(&p.life[i], _mm256_sub_ps(_mm256_loadu_ps(&p.life[i]), step));
+            }
+
+            for (; i < count; i++)
+            {
+                p.x[i] += p.velocityX[i] * dt;
+                p.y[i] += p.velocityY[i] * dt;
+                p.rotation[i] += p.rotationVelocity[i] * dt;
+                p.life[i] -= dt;
+            }
         }
+#endif
 
-        float life = m_lifeRemaining / m_props.lifeTime;
-        SetColor(glm::lerp(m_props.deathColor, m_props.birthColor, life));
-        SetScale(glm::lerp(glm::vec2(0.f), m_props.size, life));
+        ParticleKernel SelectKernel()
+        {
+#ifdef ANT_X86_SIMD
+            if (CpuHasAvx2())
+                return {"avx2", UpdateAvx2};
+
+            return {"sse2", UpdateSse2};
+#else
+            return {"scalar", UpdateScalar};
+#endif
+        }
 
-        glm::vec2 vel = {
-            m_props.velocity.x * m_props.velocityVariation.x * (Random::Float() - 0.5f),
-            m_props.velocity.y * m_props.velocityVariation.y * (Random::Float() - 0.5f)};
+        constexpr uint32_t s_minDrawSlice = 16384; // instances filled per job
+    } // namespace
 
-        m_props.velocity = vel;
+    const ParticleKernel &GetParticleKernel()
+    {
+        static const ParticleKernel kernel = SelectKernel();
+        return kernel;
+    }
 
-        m_props.position += vel * TimeStep::GetFrameTime().Seconds();
-        SetPosition({m_props.position, 1.f});
+    void ParticleArrays::Resize(uint32_t capacity)
+    {
+        for (auto array : {&x, &y, &velocityX, &velocityY, &rotation, &rotationVelocity, &life, &inverseLifeTime})
+            array->resize(capacity);
 
-        float rot = m_props.rotationVelocity * m_props.rotationVelocityVariation * (Random::Float() - 0.5f);
-        m_props.rotation += rot * TimeStep::GetFrameTime().Seconds();
-        // m_props.rotation = rot; //! another way of animating
-        SetRotation(glm::radians(m_props.rotation));
+        size.resize(capacity);
+        birthColor.resize(capacity);
+        deathColor.resize(capacity);
     }
 
-    void Particle::SetProps(const ParticleProps &props)
+    void ParticleArrays::Move(uint32_t from, uint32_t to)
     {
-        m_props = props;
-        m_lifeRemaining = m_props.lifeTime;
+        x[to] = x[from];
+        y[to] = y[from];
+        velocityX[to] = velocityX[from];
+        velocityY[to] = velocityY[from];
+        rotation[to] = rotation[from];
+        rotationVelocity[to] = rotationVelocity[from];
+        life[to] = life[from];
+        inverseLifeTime[to] = inverseLifeTime[from];
+        size[to] = size[from];
+        birthColor[to] = birthColor[from];
+        deathColor[to] = deathColor[from];
     }
 
-    ParticleSystem::ParticleSystem()
+    ParticleSystem::ParticleSystem(uint32_t capacity, ParticleBackend backend)
+        : m_capacity(capacity), m_backend(backend)
     {
-        m_particles.resize(CountLimit);
+        m_particles.Resize(capacity);
+
+        if (m_backend == ParticleBackend::Compute && !ParticleComputeBackend::IsSupported())
+        {
+            CORE_WARN("Compute shaders are not supported, ParticleSystem runs on the cpu");
+            m_backend = ParticleBackend::Cpu;
+        }
+
+        if (m_backend == ParticleBackend::Compute)
+        {
+            m_compute = std::make_unique<ParticleComputeBackend>(capacity);
+            CORE_INFO("ParticleSystem of {0} particles, compute backend", capacity);
+        }
+        else
+            CORE_INFO("ParticleSystem of {0} particles, {1} update kernel", capacity, m_kernel.name);
     }
 
-    void ParticleSystem::OnUpdate()
+    void ParticleSystem::OnUpdate(TimeStep dt)
     {
-        CORE_PROFILE_FUNC();
-        for (auto &&i : m_particles)
-            i.OnUpdate();
+        CORE_PROFILE_FUNC_CAT(Render);
+        if (m_compute)
+        {
+            m_compute->OnUpdate(dt.Seconds());
+            m_aliveCount = m_compute->GetAliveBound();
+            return;
+        }
+
+        m_kernel.update(m_particles, m_aliveCount, dt.Seconds());
+
+        //? swap remove, walking backwards every particle past i is already known to be alive
+        auto &life = m_particles.life;
+        for (uint32_t i = m_aliveCount; i-- > 0;)
+        {
+            if (life[i] > 0.f)
+                continue;
+
+            m_aliveCount--;
+            if (i != m_aliveCount)
+                m_particles.Move(m_aliveCount, i);
+        }
     }
 
     void ParticleSystem::OnDraw()
     {
-        CORE_PROFILE_FUNC();
-        for (auto &&i : m_particles)
+        CORE_PROFILE_FUNC_CAT(Render);
+        if (m_compute)
         {
-            if (!i.m_active)
-                continue;
-            Renderer2D::DrawShape(i);
+            m_compute->OnDraw(m_depth);
+            return;
+        }
+
+        Renderer2D::DrawInstances(m_aliveCount, [this](QuadInstance *out, uint32_t first, uint32_t count)
+                                  { JobSystem::ParallelFor(count, s_minDrawSlice, [&](uint32_t begin, uint32_t end)
+                                                           { WriteInstances(out + begin, first + begin, end - begin); }); });
+    }
+
+    void ParticleSystem::WriteInstances(QuadInstance *out, uint32_t first, uint32_t count) const
+    {
+        auto &p = m_particles;
+
+        for (uint32_t k = 0; k < count; k++)
+        {
+            uint32_t i = first + k;
+            float t = p.life[i] * p.inverseLifeTime[i]; // 1 at birth, 0 at death
+            glm::vec2 size = p.size[i] * t;
+            float sine = std::sin(p.rotation[i]);
+            float cosine = std::cos(p.rotation[i]);
+
+            //? same axes as TransformComponent, rotate(-rotation) * scale
+            QuadInstance &instance = out[k];
+            instance.translation = {p.x[i], p.y[i], m_depth};
+            instance.xAxis = {cosine * size.x, -sine * size.x};
+            instance.yAxis = {sine * size.y, cosine * size.y};
+            instance.color = glm::packUnorm4x8(glm::mix(p.deathColor[i], p.birthColor[i], t));
+            instance.textureId = 0;
+            instance.atlasRect = {0.f, 0.f, 1.f, 1.f};
         }
     }
 
     void ParticleSystem::Emit(const ParticleProps &props)
     {
-        CORE_PROFILE_FUNC();
-        m_particles[m_emitIndex].SetProps(props);
-        m_particles[m_emitIndex].m_active = true;
+        if (m_aliveCount == m_capacity)
+            return;
+
+        //? same rolls in the same order for both backends, the same Random sequence gives both the same particles
+        glm::vec2 velocity = props.velocity;
+        velocity.x += props.velocityVariation.x * (Random::Float() - 0.5f);
+        velocity.y += props.velocityVariation.y * (Random::Float() - 0.5f);
+        float rotationVelocity = glm::radians(props.rotationVelocity + props.rotationVelocityVariation * (Random::Float() - 0.5f));
+
+        if (m_compute)
+        {
+            GpuParticle particle;
+            particle.position = props.position;
+            particle.velocity = velocity;
+            particle.size = props.size;
+            particle.rotation = glm::radians(props.rotation);
+            particle.rotationVelocity = rotationVelocity;
+            particle.life = props.lifeTime;
+            particle.inverseLifeTime = 1.f / props.lifeTime;
+            particle.birthColor = glm::packUnorm4x8(props.birthColor);
+            particle.deathColor = glm::packUnorm4x8(props.deathColor);
+
+            m_compute->Emit(particle);
+            m_aliveCount++; // bound until the next update, the gpu drops what doesn't fit
+            return;
+        }
 
-        m_emitIndex = ++m_emitIndex % (CountLimit - 1);
+        uint32_t i = m_aliveCount++;
+        auto &p = m_particles;
+
+        p.x[i] = props.position.x;
+        p.y[i] = props.position.y;
+        p.velocityX[i] = velocity.x;
+        p.velocityY[i] = velocity.y;
+        p.rotation[i] = glm::radians(props.rotation);
+        p.rotationVelocity[i] = rotationVelocity;
+        p.life[i] = props.lifeTime;
+        p.inverseLifeTime[i] = 1.f / props.lifeTime;
+        p.size[i] = props.size;
+        p.birthColor[i] = props.birthColor;
+        p.deathColor[i] = props.deathColor;
     }
 
-}
+    void ParticleSystem::ReadBack()
+    {
+        if (m_compute)
+            m_aliveCount = m_compute->ReadBack(m_particles);
+    }
 
-#endif
\ No newline at end of file
+}
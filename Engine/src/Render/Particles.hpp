@@ -1,13 +1,9 @@
 #pragma once
-
-
-
-#ifdef PARTICLES
-
 #include "Core/Core.hpp"
 #include <glm/glm.hpp>
-#include "Render/Primitive.hpp"
 #include "Core/Time.hpp"
+#include "Render/Primitive.hpp"
+#include "Render/ParticlesCompute.hpp"
 
 namespace ant
 {
@@ -19,46 +15,77 @@ namespace ant
         glm::vec2 size;
         glm::vec4 birthColor, deathColor;
         float lifeTime;
-        float rotation, rotationVelocity, rotationVelocityVariation;
+        float rotation, rotationVelocity, rotationVelocityVariation; // degrees
     };
 
-    class Particle
-        : public Quad
+    //? one array per attribute, alive particles are packed at the front
+    //? color and size are derived from the remaining life while drawing, the update only integrates
+    struct ParticleArrays
     {
-        friend class ParticleSystem;
+        std::vector<float> x, y;
+        std::vector<float> velocityX, velocityY;
+        std::vector<float> rotation, rotationVelocity; // radians
+        std::vector<float> life;                       // seconds left
+        std::vector<float> inverseLifeTime;
+        std::vector<glm::vec2> size;
+        std::vector<glm::vec4> birthColor, deathColor;
+
+        void Resize(uint32_t capacity);
+        void Move(uint32_t from, uint32_t to);
+    };
 
-    public:
-        Particle() {}
-        Particle(const ParticleProps &props);
-        ~Particle() {}
+    //? integrates [0, count), written for sse2 and avx2 like the quad transform kernels
+    struct ParticleKernel
+    {
+        const char *name;
+        void (*update)(ParticleArrays &particles, uint32_t count, float dt);
+    };
 
-        void OnUpdate();
-        void SetProps(const ParticleProps &props);
-        ParticleProps &GetProps() { return m_props; }
+    // best kernel for this cpu (avx2, sse2 or scalar), selected on first call
+    const ParticleKernel &GetParticleKernel();
 
-    private:
-        ParticleProps m_props;
-        bool m_active = false;
-        float m_lifeRemaining;
+    enum class ParticleBackend : uint8_t
+    {
+        Cpu = 0, // simd kernels, instances streamed every frame
+        Compute  // compute shader over storage buffers, drawn indirectly, falls back to Cpu without gl 4.5
     };
 
     class ParticleSystem
     {
     public:
-        ParticleSystem();
+        ParticleSystem(uint32_t capacity = 1 << 20, ParticleBackend backend = ParticleBackend::Cpu);
         ~ParticleSystem() {}
 
-        void OnUpdate();
+        //! the compute backend makes gl calls here, when pipelined call it from the render packet like OnDraw
+        void OnUpdate(TimeStep dt = TimeStep::GetFrameTime());
+        //! between Renderer2D::BeginScene and EndScene, the cpu backend needs an instancing renderer
         void OnDraw();
 
+        //? variations are rolled once here for both backends, emitting into a full system drops the particle
         void Emit(const ParticleProps &props);
 
+        //? brings the particles of the compute backend back into GetParticles, stalls until the gpu is done
+        //? order differs from the cpu backend, compare them as sets
+        void ReadBack();
+
+        //? exact for the cpu backend, an upper bound for the compute backend until ReadBack
+        inline uint32_t GetAliveCount() const { return m_aliveCount; }
+        inline uint32_t GetCapacity() const { return m_capacity; }
+        inline ParticleBackend GetBackend() const { return m_backend; }
+        inline const ParticleArrays &GetParticles() const { return m_particles; } // [0, GetAliveCount()) is alive
+        inline void SetDepth(float depth) { m_depth = depth; }
+
+    private:
+        void WriteInstances(QuadInstance *out, uint32_t first, uint32_t count) const; // called from job workers
+
     private:
-        static constexpr size_t CountLimit = 1000;
-        size_t m_emitIndex = 0;
-        std::vector<Particle> m_particles;
+        uint32_t m_capacity;
+        uint32_t m_aliveCount = 0;
+        float m_depth = 1.f;
+        ParticleBackend m_backend;
+        ParticleArrays m_particles;
+        UniqueRef<ParticleComputeBackend> m_compute; // only with ParticleBackend::Compute
+        const ParticleKernel &m_kernel = GetParticleKernel();
     };
 
 }
-
-#endif
\ No newline at end of file
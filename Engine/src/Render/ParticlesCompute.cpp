@@ -0,0 +1,172 @@
+#include "Pch.h"
+#include "Render/ParticlesCompute.hpp"
+#include "Render/Particles.hpp"
+#include "Render/Renderer.hpp"
+#include "Graphics/Shader.hpp"
+#include "debug/Instrumentation.hpp"
+#include <glm/gtc/packing.hpp>
+#include <Gl.h>
+
+namespace ant
+{
+    namespace
+    {
+        constexpr uint32_t s_groupSize = 256; // local_size_x of shaders/ParticlesCompute.glsl
+        constexpr uint32_t s_vertexCount = 6;  // two triangles per particle, no index buffer
+
+        //? storage buffer bindings of the shaders, 0 is left to the bindless texture handles of Renderer2D
+        enum : uint32_t
+        {
+            inputBinding = 4,
+            outputBinding = 5,
+            emittedBinding = 6,
+            commandsBinding = 7
+        };
+    } // namespace
+
+    ParticleComputeBackend::ParticleComputeBackend(uint32_t capacity)
+        : m_capacity(capacity)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        glCreateBuffers(2, m_particles);
+        for (auto buffer : m_particles)
+            glNamedBufferStorage(buffer, size_t(capacity) * sizeof(GpuParticle), nullptr, 0);
+
+        DrawCommand commands[2] = {{s_vertexCount, 0, 0, 0}, {s_vertexCount, 0, 0, 0}};
+        glCreateBuffers(1, &m_commands);
+        glNamedBufferStorage(m_commands, sizeof(commands), commands, GL_DYNAMIC_STORAGE_BIT);
+
+        m_computeShader = Shader::Create("shaders/ParticlesCompute.glsl");
+        m_computeShader->CreateShader();
+        m_drawShader = Shader::Create("shaders/Particles.glsl");
+        m_drawShader->CreateShader();
+    }
+
+    ParticleComputeBackend::~ParticleComputeBackend()
+    {
+        glDeleteBuffers(2, m_particles);
+        glDeleteBuffers(1, &m_commands);
+
+        if (m_emittedBuffer)
+            glDeleteBuffers(1, &m_emittedBuffer);
+    }
+
+    bool ParticleComputeBackend::IsSupported()
+    {
+        //? the shaders are #version 450 and the buffers are made with direct state access, the extensions alone don't cover that
+        return GLEW_VERSION_4_5;
+    }
+
+    void ParticleComputeBackend::ReserveEmitted(size_t count)
+    {
+        if (count <= m_emittedCapacity)
+            return;
+
+        //? grows like the bindless handles buffer, emission bursts don't reallocate every frame
+        m_emittedCapacity = std::max<size_t>(count, 2 * m_emittedCapacity);
+        if (m_emittedBuffer)
+            glDeleteBuffers(1, &m_emittedBuffer);
+
+        glCreateBuffers(1, &m_emittedBuffer);
+        glNamedBufferStorage(m_emittedBuffer, m_emittedCapacity * sizeof(GpuParticle), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+
+    void ParticleComputeBackend::OnUpdate(float dt)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        uint32_t output = 1 - m_input;
+        uint32_t emitCount = std::min<size_t>(m_emitted.size(), m_capacity);
+
+        if (emitCount)
+        {
+            ReserveEmitted(emitCount);
+            glNamedBufferSubData(m_emittedBuffer, 0, emitCount * sizeof(GpuParticle), m_emitted.data());
+        }
+
+        uint32_t zero = 0;
+        glNamedBufferSubData(m_commands, output * sizeof(DrawCommand) + offsetof(DrawCommand, instanceCount), sizeof(zero), &zero);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, inputBinding, m_particles[m_input]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, outputBinding, m_particles[output]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, emittedBinding, m_emittedBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, commandsBinding, m_commands);
+
+        m_computeShader->BindShader();
+        m_computeShader->SetUniform("u_dt") = dt;
+        m_computeShader->SetUniform("u_emitCount") = int(emitCount);
+        m_computeShader->SetUniform("u_input") = int(m_input);
+        m_computeShader->SetUniform("u_capacity") = int(m_capacity);
+
+        //? the alive count stays on the gpu, the bound only decides how many invocations exit early
+        uint32_t invocations = std::min(m_aliveBound, m_capacity) + emitCount;
+        if (invocations)
+            glDispatchCompute((invocations + s_groupSize - 1) / s_groupSize, 1, 1);
+
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+        m_input = output;
+
+        //? a batch is dropped one update after its longest life ran out, float rounding can't make the bound too small
+        std::erase_if(m_batches, [](const EmitBatch &batch)
+                      { return batch.life <= 0.f; });
+
+        if (emitCount)
+        {
+            EmitBatch batch = {0.f, emitCount};
+            for (uint32_t i = 0; i < emitCount; i++)
+                batch.life = std::max(batch.life, m_emitted[i].life);
+            m_batches.push_back(batch);
+        }
+
+        m_aliveBound = 0;
+        for (auto &batch : m_batches)
+        {
+            batch.life -= dt;
+            m_aliveBound += batch.count;
+        }
+
+        m_aliveBound = std::min(m_aliveBound, m_capacity);
+        m_emitted.clear();
+    }
+
+    void ParticleComputeBackend::OnDraw(float depth)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, inputBinding, m_particles[m_input]);
+
+        m_drawShader->BindShader();
+        m_drawShader->SetUniform("u_depth") = depth;
+        m_drawShader->SetUniform("u_capacity") = int(m_capacity);
+
+        Renderer2D::DrawArraysIndirect(m_drawShader, m_commands, m_input * sizeof(DrawCommand));
+    }
+
+    uint32_t ParticleComputeBackend::ReadBack(ParticleArrays &particles)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        DrawCommand command;
+        glGetNamedBufferSubData(m_commands, m_input * sizeof(DrawCommand), sizeof(command), &command);
+        uint32_t count = std::min(command.instanceCount, m_capacity);
+
+        std::vector<GpuParticle> gpuParticles(count);
+        glGetNamedBufferSubData(m_particles[m_input], 0, count * sizeof(GpuParticle), gpuParticles.data());
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            auto &p = gpuParticles[i];
+            particles.x[i] = p.position.x;
+            particles.y[i] = p.position.y;
+            particles.velocityX[i] = p.velocity.x;
+            particles.velocityY[i] = p.velocity.y;
+            particles.rotation[i] = p.rotation;
+            particles.rotationVelocity[i] = p.rotationVelocity;
+            particles.life[i] = p.life;
+            particles.inverseLifeTime[i] = p.inverseLifeTime;
+            particles.size[i] = p.size;
+            particles.birthColor[i] = glm::unpackUnorm4x8(p.birthColor);
+            particles.deathColor[i] = glm::unpackUnorm4x8(p.deathColor);
+        }
+
+        return count;
+    }
+
+}
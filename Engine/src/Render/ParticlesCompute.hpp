@@ -0,0 +1,82 @@
+#pragma once
+#include "Core/Core.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace ant
+{
+    class Shader;
+    struct ParticleArrays;
+
+    //? std430 layout of the Particle struct in shaders/ParticlesCompute.glsl and shaders/Particles.glsl
+    struct GpuParticle
+    {
+        glm::vec2 position;
+        glm::vec2 velocity;
+        glm::vec2 size;
+        float rotation, rotationVelocity; // radians
+        float life;
+        float inverseLifeTime;
+        uint32_t birthColor, deathColor; // packed rgba8
+    };
+
+    static_assert(sizeof(GpuParticle) == 48, "GpuParticle has to match the std430 layout of the shaders!");
+
+    //? particles live in two storage buffers, every update reads one and appends the survivors to the other
+    //? the alive count never leaves the gpu, it is the instance count of the indirect draw
+    //! every call makes gl calls, use it on the thread that owns the context
+    class ParticleComputeBackend
+    {
+    public:
+        ParticleComputeBackend(uint32_t capacity);
+        ~ParticleComputeBackend();
+
+        ParticleComputeBackend(const ParticleComputeBackend &) = delete;
+        ParticleComputeBackend &operator=(const ParticleComputeBackend &) = delete;
+
+        static bool IsSupported(); // gl 4.5, compute shaders, indirect draws and direct state access
+
+        inline void Emit(const GpuParticle &particle) { m_emitted.push_back(particle); } // uploaded by the next update
+        void OnUpdate(float dt);
+        void OnDraw(float depth);
+
+        //? copies the alive particles back into particles, for tests and debugging, stalls the pipeline
+        uint32_t ReadBack(ParticleArrays &particles);
+
+        //? upper bound of the alive particles, tracked on the cpu from the emitted lifetimes
+        inline uint32_t GetAliveBound() const { return m_aliveBound; }
+
+    private:
+        void ReserveEmitted(size_t count);
+
+    private:
+        struct DrawCommand
+        {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t first;
+            uint32_t baseInstance;
+        };
+
+        struct EmitBatch
+        {
+            float life;     // longest life left in the batch
+            uint32_t count;
+        };
+
+        uint32_t m_capacity;
+        uint32_t m_input = 0; // buffer holding the current particles, the other one is written by the next update
+        uint32_t m_particles[2]{};
+        uint32_t m_commands = 0; // one DrawCommand per particle buffer
+        uint32_t m_emittedBuffer = 0;
+        size_t m_emittedCapacity = 0;
+
+        std::vector<GpuParticle> m_emitted;
+        std::vector<EmitBatch> m_batches; // per update that emitted
+        uint32_t m_aliveBound = 0;
+
+        Ref<Shader> m_computeShader;
+        Ref<Shader> m_drawShader;
+    };
+
+}
@@ -12,6 +12,7 @@ namespace ant
     }
 
     INT_VERTEX_LAYOUT_DECL
+    INT_QUAD_INSTANCE_LAYOUT_DECL
 
     OldQuad::OldQuad()
     {
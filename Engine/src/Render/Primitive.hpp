@@ -17,6 +17,19 @@ namespace ant
         #define INT_VERTEX_LAYOUT_DECL VertexBufferLayout Vertex::layout = {AttributeType::vec4f, AttributeType::vec4f, AttributeType::vec2f, AttributeType::vec1f};
     };
 
+    //? one record per quad, corners are expanded in the vertex shader
+    struct QuadInstance
+    {
+        glm::vec3 translation; // world, z is depth
+        glm::vec2 xAxis;       // world affine columns, TransformComponent::GetAffine
+        glm::vec2 yAxis;
+        uint32_t color; // packed RGBA8
+        uint32_t textureId;
+        glm::vec4 atlasRect; // uv min, uv max
+        static VertexBufferLayout layout;
+        #define INT_QUAD_INSTANCE_LAYOUT_DECL VertexBufferLayout QuadInstance::layout = {AttributeType::vec3f, AttributeType::vec2f, AttributeType::vec2f, AttributeType::vec1ui, AttributeType::vec1ui, AttributeType::vec4f};
+    };
+
     class OldQuad
         : public TransformComponent
     {
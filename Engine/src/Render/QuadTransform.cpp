@@ -0,0 +1,218 @@
+#include "Pch.h"
+#include "Render/QuadTransform.hpp"
+#include "Core/Cpu.hpp"
+
+#include <cstddef>
+
+#ifdef ANT_X86_SIMD
+#define ANT_QUAD_SIMD
+#endif
+
+namespace ant
+{
+    namespace
+    {
+        constexpr uint32_t batchCapacity = QuadTransformBatch::capacity;
+
+        // corners in Quad vertex order, see Quad::Quad
+        constexpr float s_cornerX[4] = {-0.5f, -0.5f, 0.5f, 0.5f};
+        constexpr float s_cornerY[4] = {0.5f, -0.5f, -0.5f, 0.5f};
+
+        //? world = xAxis * cx + yAxis * cy + translation
+        void TransformScalar(const QuadTransformBatch &batch, Vertex *out)
+        {
+            for (uint32_t q = 0; q < batch.count; q++)
+            {
+                for (uint32_t k = 0; k < 4; k++)
+                {
+                    Vertex vertex = batch.vertices[q][k];
+                    vertex.position = {batch.xAxisX[q] * s_cornerX[k] + batch.yAxisX[q] * s_cornerY[k] + batch.x[q],
+                                       batch.xAxisY[q] * s_cornerX[k] + batch.yAxisY[q] * s_cornerY[k] + batch.y[q],
+                                       batch.z[q], 1.f};
+                    out[4 * q + k] = vertex;
+                }
+            }
+        }
+
+#ifdef ANT_QUAD_SIMD
+        struct QuadCorners
+        {
+            alignas(32) float x[4][batchCapacity];
+            alignas(32) float y[4][batchCapacity];
+        };
+
+        inline __m128 Blend(__m128 mask, __m128 value, __m128 base)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, value), _mm_andnot_ps(mask, base));
+        }
+
+        //? a quad is 4 * 11 floats = 11 sse registers, quads keep the 16 byte alignment of the mapped region
+        //? the registers are assembled from the copied vertices with the positions blended in, then streamed
+        //? past the cache, staging the quad in memory instead would stall on store forwarding
+        //! no sfence here, draining the write combining buffers every batch serializes the stores
+        void StreamQuads(const QuadTransformBatch &batch, const QuadCorners &corners, Vertex *out)
+        {
+            static_assert(sizeof(Vertex) == 11 * sizeof(float) && offsetof(Vertex, position) == 0, "stream layout expects a packed Vertex");
+
+            const __m128 lane0 = _mm_castsi128_ps(_mm_setr_epi32(-1, 0, 0, 0));
+            const __m128 lane3 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+            const __m128 lanes01 = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, 0, 0));
+            const __m128 lanes23 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, -1, -1));
+            const __m128 lanes012 = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+            const __m128 lanes123 = _mm_castsi128_ps(_mm_setr_epi32(0, -1, -1, -1));
+
+            bool aligned = (uintptr_t(out) & 15) == 0;
+
+            for (uint32_t q = 0; q < batch.count; q++)
+            {
+                auto src = reinterpret_cast<const float *>(batch.vertices[q].data());
+                auto dst = reinterpret_cast<float *>(out + 4 * q);
+
+                __m128 p0 = _mm_setr_ps(corners.x[0][q], corners.y[0][q], batch.z[q], 1.f);
+                __m128 p1 = _mm_setr_ps(corners.x[1][q], corners.y[1][q], batch.z[q], 1.f);
+                __m128 p2 = _mm_setr_ps(corners.x[2][q], corners.y[2][q], batch.z[q], 1.f);
+                __m128 p3 = _mm_setr_ps(corners.x[3][q], corners.y[3][q], batch.z[q], 1.f);
+
+                // vertex k starts at float 11 * k
+                __m128 chunks[11];
+                chunks[0] = p0;
+                chunks[1] = _mm_loadu_ps(src + 4);
+                chunks[2] = Blend(lane3, _mm_shuffle_ps(p1, p1, _MM_SHUFFLE(0, 0, 0, 0)), _mm_loadu_ps(src + 8));
+                chunks[3] = Blend(lanes012, _mm_shuffle_ps(p1, p1, _MM_SHUFFLE(3, 3, 2, 1)), _mm_loadu_ps(src + 12));
+                chunks[4] = _mm_loadu_ps(src + 16);
+                chunks[5] = Blend(lanes23, _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(1, 0, 0, 0)), _mm_loadu_ps(src + 20));
+                chunks[6] = Blend(lanes01, _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 3, 2)), _mm_loadu_ps(src + 24));
+                chunks[7] = _mm_loadu_ps(src + 28);
+                chunks[8] = Blend(lanes123, _mm_shuffle_ps(p3, p3, _MM_SHUFFLE(2, 1, 0, 0)), _mm_loadu_ps(src + 32));
+                chunks[9] = Blend(lane0, _mm_shuffle_ps(p3, p3, _MM_SHUFFLE(3, 3, 3, 3)), _mm_loadu_ps(src + 36));
+                chunks[10] = _mm_loadu_ps(src + 40);
+
+                if (aligned)
+                {
+                    for (size_t i = 0; i < 11; i++)
+                        _mm_stream_ps(dst + 4 * i, chunks[i]);
+                }
+                else
+                {
+                    for (size_t i = 0; i < 11; i++)
+                        _mm_storeu_ps(dst + 4 * i, chunks[i]);
+                }
+            }
+        }
+
+        void TransformSse2(const QuadTransformBatch &batch, Vertex *out)
+        {
+            QuadCorners corners;
+
+            for (uint32_t q = 0; q < batch.count; q += 4)
+            {
+                __m128 a = _mm_load_ps(batch.xAxisX + q);
+                __m128 d = _mm_load_ps(batch.xAxisY + q);
+                __m128 b = _mm_load_ps(batch.yAxisX + q);
+                __m128 e = _mm_load_ps(batch.yAxisY + q);
+                __m128 tx = _mm_load_ps(batch.x + q);
+                __m128 ty = _mm_load_ps(batch.y + q);
+
+                for (uint32_t k = 0; k < 4; k++)
+                {
+                    __m128 cx = _mm_set1_ps(s_cornerX[k]);
+                    __m128 cy = _mm_set1_ps(s_cornerY[k]);
+
+                    __m128 px = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, cx), _mm_mul_ps(b, cy)), tx);
+                    __m128 py = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d, cx), _mm_mul_ps(e, cy)), ty);
+
+                    _mm_store_ps(corners.x[k] + q, px);
+                    _mm_store_ps(corners.y[k] + q, py);
+                }
+            }
+
+            StreamQuads(batch, corners, out);
+        }
+
+        ANT_TARGET_AVX2 void TransformAvx2(const QuadTransformBatch &batch, Vertex *out)
+        {
+            static_assert(batchCapacity == 8, "avx2 kernel transforms the whole batch at once");
+
+            QuadCorners corners;
+
+            __m256 a = _mm256_load_ps(batch.xAxisX);
+            __m256 d = _mm256_load_ps(batch.xAxisY);
+            __m256 b = _mm256_load_ps(batch.yAxisX);
+            __m256 e = _mm256_load_ps(batch.yAxisY);
+            __m256 tx = _mm256_load_ps(batch.x);
+            __m256 ty = _mm256_load_ps(batch.y);
+
+            for (uint32_t k = 0; k < 4; k++)
+            {
+                __m256 cx = _mm256_set1_ps(s_cornerX[k]);
+                __m256 cy = _mm256_set1_ps(s_cornerY[k]);
+
+                _mm256_store_ps(corners.x[k], _mm256_fmadd_ps(a, cx, _mm256_fmadd_ps(b, cy, tx)));
+                _mm256_store_ps(corners.y[k], _mm256_fmadd_ps(d, cx, _mm256_fmadd_ps(e, cy, ty)));
+            }
+
+            StreamQuads(batch, corners, out);
+        }
+#endif
+
+        QuadTransformKernel SelectKernel()
+        {
+#ifdef ANT_QUAD_SIMD
+            if (CpuHasAvx2())
+                return {"avx2", TransformAvx2};
+
+            return {"sse2", TransformSse2};
+#else
+            return {"scalar", TransformScalar};
+#endif
+        }
+
+    } // namespace
+
+    void QuadTransformBatch::Push(const std::array<Vertex, 4> &quadVertices, const TransformComponent &transform)
+    {
+        CORE_ASSERT(!IsFull(), "Quad transform batch is full!");
+        CORE_ASSERT(!transform.IsDirty(), "Quad transform pushed before its matrix was calculated!");
+        auto &affine = transform.GetAffine();
+
+        x[count] = affine[2][0];
+        y[count] = affine[2][1];
+        z[count] = transform.GetDepth();
+        xAxisX[count] = affine[0][0];
+        xAxisY[count] = affine[0][1];
+        yAxisX[count] = affine[1][0];
+        yAxisY[count] = affine[1][1];
+        vertices[count] = quadVertices;
+        count++;
+    }
+
+    void FenceQuadTransforms()
+    {
+#ifdef ANT_QUAD_SIMD
+        _mm_sfence();
+#endif
+    }
+
+    const QuadTransformKernel &GetQuadTransformKernel()
+    {
+        static const QuadTransformKernel kernel = SelectKernel();
+        return kernel;
+    }
+
+    std::span<const QuadTransformKernel> GetQuadTransformKernels()
+    {
+        static const std::vector<QuadTransformKernel> kernels = []
+        {
+            std::vector<QuadTransformKernel> kernels = {{"scalar", TransformScalar}};
+#ifdef ANT_QUAD_SIMD
+            kernels.push_back({"sse2", TransformSse2});
+            if (CpuHasAvx2())
+                kernels.push_back({"avx2", TransformAvx2});
+#endif
+            return kernels;
+        }();
+
+        return kernels;
+    }
+
+} // namespace ant
@@ -0,0 +1,46 @@
+#pragma once
+#include "Render/Primitive.hpp"
+#include <span>
+
+namespace ant
+{
+
+    //? SoA staging for Quad + TransformComponent draws, transformed together once full
+    //? takes the cached 2D affine of TransformComponent, columns are x axis, y axis and translation
+    struct QuadTransformBatch
+    {
+        static constexpr uint32_t capacity = 8;
+
+        alignas(32) float x[capacity]{};
+        alignas(32) float y[capacity]{};
+        alignas(32) float z[capacity]{};
+        alignas(32) float xAxisX[capacity]{};
+        alignas(32) float xAxisY[capacity]{};
+        alignas(32) float yAxisX[capacity]{};
+        alignas(32) float yAxisY[capacity]{};
+        std::array<Vertex, 4> vertices[capacity]; // copied quad vertices, give color, uv and texture id
+        uint32_t count = 0;
+
+        inline bool IsFull() const { return count == capacity; }
+        //! transform has to be up to date (CalculateTranformationMatrix)
+        void Push(const std::array<Vertex, 4> &quadVertices, const TransformComponent &transform);
+    };
+
+    //? writes 4 * batch.count vertices to out, positions come from the unit quad corners of Quad
+    //! streaming kernels bypass the cache, out is write only memory (mapped stream region)
+    struct QuadTransformKernel
+    {
+        const char *name;
+        void (*transform)(const QuadTransformBatch &batch, Vertex *out);
+    };
+
+    //! streamed vertices are only ordered before later stores (and the draw call) after this fence
+    void FenceQuadTransforms();
+
+    // best kernel for this cpu (avx2, sse2 or scalar), selected on first call
+    const QuadTransformKernel &GetQuadTransformKernel();
+
+    //? every kernel this cpu can run, scalar first, for tests and benchmarks
+    std::span<const QuadTransformKernel> GetQuadTransformKernels();
+
+} // namespace ant
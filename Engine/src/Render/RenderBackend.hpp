@@ -0,0 +1,14 @@
+#pragma once
+#include <stdint.h>
+
+namespace ant
+{
+    //? what Window::Init creates the gl context with
+    enum class RenderBackend : uint8_t
+    {
+        Native = 0, // a visible glfw window and the driver of the machine
+        Offscreen,  // a hidden window with a software (osmesa) or egl context, on the glfw 3.4 null platform no display is needed
+        Null        // no window and no context, gl calls land in NullGl and nothing is drawn
+    };
+
+} // namespace ant
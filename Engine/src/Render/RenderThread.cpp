@@ -0,0 +1,114 @@
+#include "Pch.h"
+#include "Render/RenderThread.hpp"
+#include "Graphics/Window.hpp"
+#include "Core/JobSystem.hpp"
+#include <Gl.h>
+#include <chrono>
+
+namespace ant
+{
+    void RenderPacket::Execute()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        for (auto &command : m_commands)
+            command();
+    }
+
+    RenderThread::RenderThread(Window &window, uint32_t latency)
+        : m_window(window), m_packets(latency + 1)
+    {
+        CORE_ASSERT(latency, "RenderThread needs at least one frame of latency!");
+        m_window.ReleaseContext(); // a context is current on one thread at a time
+        m_thread = std::thread(&RenderThread::Loop, this);
+        CORE_INFO("Render thread started, {0} frame(s) of latency", latency);
+    }
+
+    RenderThread::~RenderThread()
+    {
+        WaitIdle();
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_submittedCondition.notify_one();
+        m_thread.join();
+        m_window.MakeContextCurrent(); // layers detach with the context back on this thread
+    }
+
+    RenderPacket &RenderThread::BeginPacket()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        auto start = std::chrono::steady_clock::now();
+        std::unique_lock lock(m_mutex);
+        m_finishedCondition.wait(lock, [this]
+                                 { return m_submitted - m_finished < m_packets.size(); });
+        m_stats.updateStallMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        auto &packet = m_packets[m_submitted % m_packets.size()];
+        packet.Clear();
+        return packet;
+    }
+
+    void RenderThread::SubmitPacket()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_submitted++;
+        }
+
+        m_submittedCondition.notify_one();
+    }
+
+    void RenderThread::WaitIdle()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        std::unique_lock lock(m_mutex);
+        m_finishedCondition.wait(lock, [this]
+                                 { return m_finished == m_submitted; });
+    }
+
+    RenderThread::Stats RenderThread::GetStats()
+    {
+        std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+
+    void RenderThread::Loop()
+    {
+        m_window.MakeContextCurrent();
+        JobSystem::RegisterThread(); // draws may go wide, Renderer2D::DrawQuads and ParticleSystem::OnDraw
+
+        while (true)
+        {
+            RenderPacket *packet;
+            {
+                std::unique_lock lock(m_mutex);
+                m_submittedCondition.wait(lock, [this]
+                                          { return m_stop || m_finished != m_submitted; });
+
+                if (m_finished == m_submitted)
+                    break; // stopping with nothing left to draw
+
+                packet = &m_packets[m_finished % m_packets.size()];
+            }
+
+            //? the update thread doesn't touch this packet until m_finished moves past it
+            auto start = std::chrono::steady_clock::now();
+            packet->Execute();
+            float renderMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_finished++;
+                m_stats.renderMs = renderMs;
+            }
+
+            m_finishedCondition.notify_all();
+        }
+
+        JobSystem::UnregisterThread();
+        m_window.ReleaseContext();
+    }
+
+} // namespace ant
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace ant
+{
+    class Window;
+
+    //? everything the render thread needs to draw one frame, filled by the update thread
+    //! commands run later on the render thread, capture copies of the state they draw, not references to it
+    class RenderPacket
+    {
+    public:
+        template <class Fn>
+        void Submit(Fn &&command) { m_commands.emplace_back(std::forward<Fn>(command)); }
+
+        void Execute();
+        inline void Clear() { m_commands.clear(); } // keeps the capacity for the next frame
+
+    private:
+        std::vector<std::function<void()>> m_commands;
+    };
+
+    //? owns the gl context while it runs, consumes packets in submission order
+    //? the update thread may run at most latency frames ahead of the frame being drawn
+    class RenderThread
+    {
+    public:
+        struct Stats
+        {
+            float renderMs = 0.f;     // last packet executed, swap included
+            float updateStallMs = 0.f; // how long the last BeginPacket waited for a free packet
+        };
+
+        //! takes the gl context away from the calling thread until destruction
+        RenderThread(Window &window, uint32_t latency);
+        ~RenderThread();
+
+        RenderThread(const RenderThread &) = delete;
+        RenderThread &operator=(const RenderThread &) = delete;
+
+        RenderPacket &BeginPacket(); // waits until the render thread frees a packet
+        void SubmitPacket();          // hands the packet from BeginPacket over
+        void WaitIdle();              // waits until every submitted packet was drawn
+
+        inline uint32_t GetLatency() const { return uint32_t(m_packets.size()) - 1; }
+        Stats GetStats();
+
+    private:
+        void Loop();
+
+    private:
+        Window &m_window;
+        std::vector<RenderPacket> m_packets; // ring of latency + 1
+        uint64_t m_submitted = 0;            // packets handed over
+        uint64_t m_finished = 0;             // packets drawn
+        bool m_stop = false;
+        Stats m_stats;
+
+        std::mutex m_mutex;
+        std::condition_variable m_submittedCondition;
+        std::condition_variable m_finishedCondition;
+        std::thread m_thread;
+    };
+
+} // namespace ant
@@ -4,11 +4,16 @@
 #include "Render/Renderer.hpp"
 #include "Graphics/FrameBuffer.hpp"
 #include <Gl.h>
+#include <glm/gtc/packing.hpp>
+#include <bit>
+#include "Core/RadixSort.hpp"
+#include "debug/Metrics.hpp"
 
 namespace ant
 {
     Renderer2D::SceneData Renderer2D::s_sceneData;
     Renderer2D::RendererStats Renderer2D::s_stats;
+    Renderer2D::RendererStats Renderer2D::s_sceneStart;
 
     Renderer2DQueue::Renderer2DQueue()
     {
@@ -16,104 +21,258 @@ namespace ant
 
     void Renderer2DQueue::Add(OldQuad &shape)
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
+        FlushTransforms(); // keeps the pending quads contiguous
+
         auto vsize = shape.m_vertices.size();
         auto vptr = &shape.m_vertices[0];
 
-        shape.CalculateTranformationMatrix();
+        if (shape.CalculateTranformationMatrix())
+            Renderer2D::s_stats.matricesRecomputed++;
+
         auto &mat = shape.GetTransformationMatrix();
 
         for (size_t i = 0; i < vsize; i++)
         {
             Vertex vertex = vptr[i];
             vertex.position = mat * vertex.position;
-            m_vertices->at(m_verticesCount) = vertex;
+            m_vertices[m_verticesCount] = vertex;
             Renderer2D::s_stats.verticesCount++;
             m_verticesCount++;
         }
 
-        auto iptr = &shape.m_indices[0];
-        auto isize = shape.m_indices.size();
-
-        for (size_t i = 0; i < isize; i++)
-        {
-            uint32_t idx = iptr[i] + (m_objectCount * vsize);
-            m_indices->at(m_indicesCount) = idx;
-            Renderer2D::s_stats.indicesCount++;
-            m_indicesCount++;
-        }
+        //? indices come from the shared quad index buffer
+        m_indicesCount += shape.m_indices.size();
+        Renderer2D::s_stats.indicesCount += shape.m_indices.size();
         m_objectCount++;
+        m_sceneQuadsCount++;
 
         Renderer2D::s_stats.shapesCount++;
     }
 
+    //? called once per quad under a profiled caller, so no profile scope of its own
     void Renderer2DQueue::Add(Quad &shape, TransformComponent &transform)
     {
-        CORE_PROFILE_FUNC();
-        auto vsize = shape.m_vertices.size();
-        auto vptr = &shape.m_vertices[0];
+        if (transform.CalculateTranformationMatrix())
+            Renderer2D::s_stats.matricesRecomputed++;
 
-        transform.CalculateTranformationMatrix();
-        auto &mat = transform.GetTransformationMatrix();
+        m_transformBatch.Push(shape.m_vertices, transform);
+        m_verticesCount += shape.m_vertices.size();
+        Renderer2D::s_stats.verticesCount += shape.m_vertices.size();
 
-        for (size_t i = 0; i < vsize; i++)
+        if (m_transformBatch.IsFull())
+            FlushTransforms();
+
+        m_indicesCount += shape.s_indices.size();
+        Renderer2D::s_stats.indicesCount += shape.s_indices.size();
+        m_objectCount++;
+        m_sceneQuadsCount++;
+
+        Renderer2D::s_stats.shapesCount++;
+    }
+
+    void Renderer2DQueue::AddInstance(const Quad &shape, TransformComponent &transform, uint32_t textureId, const glm::vec4 &atlasRect)
+    {
+        if (transform.CalculateTranformationMatrix())
+            Renderer2D::s_stats.matricesRecomputed++;
+
+        FillInstance(m_instances[m_instanceCount], shape, transform, textureId, atlasRect);
+
+        m_instanceCount++;
+        m_sceneQuadsCount++;
+
+        Renderer2D::s_stats.verticesCount += shape.m_vertices.size();
+        Renderer2D::s_stats.indicesCount += shape.s_indices.size();
+        Renderer2D::s_stats.shapesCount++;
+    }
+
+    void Renderer2DQueue::FillInstance(QuadInstance &instance, const Quad &shape, const TransformComponent &transform, uint32_t textureId, const glm::vec4 &atlasRect)
+    {
+        auto &affine = transform.GetAffine();
+
+        instance.translation = {affine[2], transform.GetDepth()};
+        instance.xAxis = affine[0];
+        instance.yAxis = affine[1];
+        instance.color = glm::packUnorm4x8(shape.GetColor());
+        instance.textureId = textureId;
+        instance.atlasRect = atlasRect;
+    }
+
+    uint32_t Renderer2DQueue::WriteQuads(const QuadEntry *entries, uint32_t count, uint32_t offset)
+    {
+        CORE_PROFILE_DETAIL_CAT("Write quads slice", Render);
+        //? own staging batch per slice, m_transformBatch belongs to the main thread
+        QuadTransformBatch batch;
+        Vertex *out = m_vertices + 4 * offset;
+        uint32_t recomputed = 0;
+
+        for (uint32_t i = 0; i < count; i++)
         {
-            Vertex vertex = vptr[i];
-            vertex.position = mat * vertex.position;
-            m_vertices->at(m_verticesCount) = vertex;
-            Renderer2D::s_stats.verticesCount++;
-            m_verticesCount++;
+            recomputed += entries[i].transform->CalculateTranformationMatrix();
+            batch.Push(entries[i].shape->m_vertices, *entries[i].transform);
+
+            if (batch.IsFull())
+            {
+                m_transformKernel.transform(batch, out);
+                out += 4 * batch.count;
+                batch.count = 0;
+            }
         }
 
-        auto iptr = &shape.s_indices[0];
-        auto isize = shape.s_indices.size();
+        if (batch.count)
+            m_transformKernel.transform(batch, out);
 
-        for (size_t i = 0; i < isize; i++)
+        FenceQuadTransforms(); //! streaming stores of this thread are not covered by the fence in EndBatch
+        return recomputed;
+    }
+
+    uint32_t Renderer2DQueue::WriteInstances(const QuadEntry *entries, uint32_t count, uint32_t offset)
+    {
+        CORE_PROFILE_DETAIL_CAT("Write instances slice", Render);
+        QuadInstance *out = m_instances + offset;
+        uint32_t recomputed = 0;
+
+        for (uint32_t i = 0; i < count; i++)
         {
-            uint32_t idx = iptr[i] + (m_objectCount * vsize);
-            m_indices->at(m_indicesCount) = idx;
-            Renderer2D::s_stats.indicesCount++;
-            m_indicesCount++;
+            recomputed += entries[i].transform->CalculateTranformationMatrix();
+            FillInstance(out[i], *entries[i].shape, *entries[i].transform, 0, {0.f, 0.f, 1.f, 1.f});
         }
-        m_objectCount++;
 
-        Renderer2D::s_stats.shapesCount++;
+        return recomputed;
+    }
+
+    void Renderer2DQueue::FlushTransforms()
+    {
+        if (!m_transformBatch.count)
+            return;
+
+        Vertex *out = m_vertices + m_verticesCount - 4 * m_transformBatch.count;
+        m_transformKernel.transform(m_transformBatch, out);
+        m_transformBatch.count = 0;
     }
 
-    std::pair<float *, size_t> Renderer2DQueue::GetData()
+    bool Renderer2DQueue::MapVertices()
     {
-        return {(float *)m_vertices->data(), m_verticesCount * sizeof(Vertex)};
+        bool stalled = m_stream->Acquire();
+        m_vertices = m_stream->GetVertexPtr<Vertex>();
+        return stalled;
     }
 
-    std::pair<uint32_t *, size_t> Renderer2DQueue::GetIdxData()
+    bool Renderer2DQueue::MapInstances()
     {
-        return {m_indices->data(), m_indicesCount};
+        bool stalled = m_instanceStream->Acquire();
+        m_instances = m_instanceStream->GetVertexPtr<QuadInstance>();
+        return stalled;
     }
 
-    void Renderer2D::Init()
+    void Renderer2DQueue::Resize(uint32_t quadsLimit, bool instancing)
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
+        CORE_ASSERT(!m_objectCount && !m_instanceCount, "Resizing a non empty render queue!");
+        m_quadsLimit = quadsLimit;
+
+        //? old streams are released here, gl keeps their storage alive until pending draws finish
+        m_stream = MakeRef<StreamVertexArray>(Vertex::layout, 4 * m_quadsLimit, streamRegions);
+
+        std::vector<uint32_t> indices(Quad::s_indices.size() * m_quadsLimit);
+        for (size_t i = 0; i < indices.size(); i++)
+            indices[i] = Quad::s_indices[i % Quad::s_indices.size()] + 4 * (i / Quad::s_indices.size());
+
+        m_stream->SetIndexData(indices.data(), indices.size());
+        MapVertices();
+
+        if (instancing)
+        {
+            m_instanceStream = MakeRef<StreamVertexArray>(QuadInstance::layout, m_quadsLimit, streamRegions, 1);
+            MapInstances();
+        }
+    }
+
+    void Renderer2D::Init(const Renderer2DSettings &settings)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        s_sceneData.settings = settings;
+        auto &backend = s_sceneData.settings.textureBackend;
+        CORE_INFO("Renderer2D quad transform kernel: {0}", s_sceneData.queue.m_transformKernel.name);
+
+        if (backend != TextureBackend::Slots && !settings.instancing)
+        {
+            CORE_WARN("Texture arrays and bindless textures need instancing, using texture slots");
+            backend = TextureBackend::Slots;
+        }
+
+        if (backend == TextureBackend::Bindless && !GLEW_ARB_bindless_texture)
+        {
+            CORE_WARN("ARB_bindless_texture is not supported, using texture arrays");
+            backend = TextureBackend::Arrays;
+        }
 
         s_sceneData.shader->CreateShader();
         s_sceneData.shader->BindShader();
 
-        s_sceneData.queue.m_vertices = MakeRef<Renderer2DQueue::VertexStorage>();
-        s_sceneData.queue.m_indices = MakeRef<Renderer2DQueue::IndexStorage>();
+        if (settings.instancing)
+        {
+            const char *instanceShaders[] = {
+                "shaders/InstancedQuad.glsl",
+                "shaders/InstancedQuadArrays.glsl",
+                "shaders/InstancedQuadBindless.glsl"};
+
+            s_sceneData.instanceShader = Shader::Create(instanceShaders[uint8_t(backend)]);
+            s_sceneData.instanceShader->CreateShader();
+        }
+
+        if (backend == TextureBackend::Arrays)
+        {
+            GLint maxLayers = 0;
+            glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+            s_sceneData.arrays.maxLayers = maxLayers;
+            s_sceneData.arrays.generation++; // the budget may have changed
+            s_sceneData.textures.slotLimit = SceneData::TexturesData::unitCount / 2;
+        }
+
+        GLint64 maxElementIndex = 0;
+        glGetInteger64v(GL_MAX_ELEMENT_INDEX, &maxElementIndex);
+        s_sceneData.maxQuadsLimit = std::min<int64_t>(settings.maxQuadsLimit, maxElementIndex / 4);
+
+        s_sceneData.queue.Resize(std::min(settings.quadsLimit, s_sceneData.maxQuadsLimit), settings.instancing);
 
         auto tex = Texture::Create(glm::ivec2(1, 1));
         uint32_t data = 0xffffffff;
         tex->SetData(&data, sizeof(data));
         tex->Upload(0);
         tex->SetKeepLocalBuffer(true);
+        s_sceneData.textures.boundTextures[0] = tex->GetId();
 
         s_sceneData.defaultTexture = tex;
-        int arr[32];
+        int arr[SceneData::TexturesData::unitCount];
 
-        for (int i = 0; i < 32; i++)
+        for (int i = 0; i < SceneData::TexturesData::unitCount; i++)
             arr[i] = i;
 
         s_sceneData.shader->SetUniform("u_textures").SetAllowedDataType(Uniform::DataType::ivec1);
-        s_sceneData.shader->SetUniform("u_textures").UploadArray(arr, 32);
+        s_sceneData.shader->SetUniform("u_textures").UploadArray(arr, SceneData::TexturesData::unitCount);
+
+        if (settings.instancing)
+        {
+            auto &shader = s_sceneData.instanceShader;
+            uint32_t slotLimit = s_sceneData.textures.slotLimit;
+            shader->BindShader();
+
+            if (backend == TextureBackend::Slots || backend == TextureBackend::Arrays)
+            {
+                shader->SetUniform("u_textures").SetAllowedDataType(Uniform::DataType::ivec1);
+                shader->SetUniform("u_textures").UploadArray(arr, slotLimit);
+            }
+
+            if (backend == TextureBackend::Arrays)
+            {
+                shader->SetUniform("u_textureArrays").SetAllowedDataType(Uniform::DataType::ivec1);
+                shader->SetUniform("u_textureArrays").UploadArray(arr + slotLimit, SceneData::TexturesData::unitCount - slotLimit);
+            }
+
+            if (backend == TextureBackend::Bindless)
+                GetBindlessTextureId(tex.get()); // untextured quads use handle 0
+        }
     }
 
     void Renderer2D::OnUpdate()
@@ -123,8 +282,23 @@ namespace ant
 
     void Renderer2D::BeginScene(Ref<OrthographicCamera> camera, Ref<FrameBuffer> drawTarget)
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
         s_sceneData.camera = camera;
+        s_sceneStart = s_stats;
+
+        auto &queue = s_sceneData.queue;
+
+        if (s_sceneData.settings.autoGrow && queue.m_capacityFlushed && queue.m_quadsLimit < s_sceneData.maxQuadsLimit)
+        {
+            uint32_t limit = std::min(std::bit_ceil(queue.m_sceneQuadsCount), s_sceneData.maxQuadsLimit);
+            CORE_INFO("Renderer2D batch grows from {0} to {1} quads", queue.m_quadsLimit, limit);
+            queue.Resize(limit, s_sceneData.settings.instancing);
+        }
+
+        queue.m_sceneQuadsCount = 0;
+        queue.m_capacityFlushed = false;
+        s_sceneData.commands.scene++;
+        s_sceneData.commands.nextTextureKey = 1;
 
         if (drawTarget)
         {
@@ -132,121 +306,584 @@ namespace ant
         }
     }
 
-    void Renderer2D::DrawQuad(OldQuad &shape)
+    uint32_t Renderer2D::GetTextureSlot(Texture *texture)
     {
-        CORE_PROFILE_FUNC();
+        auto &textures = s_sceneData.textures;
 
-        if (s_sceneData.queue.m_objectCount >= Renderer2DQueue::quadsLimit)
+        if (texture->m_batchEpoch == textures.epoch)
+            return texture->GetSlot();
+
+        if (textures.count >= textures.slotLimit)
+        {
             EndBatch();
+            s_stats.textureFlushes++;
+        }
 
-        if (shape.GetTexture())
+        uint32_t slot = textures.count++;
+
+        if (textures.boundTextures[slot] != texture->GetId() || !texture->m_uploaded)
+        {
+            texture->Upload(slot);
+            textures.boundTextures[slot] = texture->GetId();
+            s_stats.textureBinds++;
+        }
+
+        texture->m_slot = slot;
+        texture->m_batchEpoch = textures.epoch;
+        return slot;
+    }
+
+    uint32_t Renderer2D::GetInstanceTextureId(Texture *texture)
+    {
+        switch (s_sceneData.settings.textureBackend)
+        {
+        case TextureBackend::Arrays:
+            return GetArrayTextureId(texture);
+
+        case TextureBackend::Bindless:
+            return GetBindlessTextureId(texture);
+
+        default:
+            return GetTextureSlot(texture);
+        }
+    }
+
+    uint32_t Renderer2D::GetArrayTextureId(Texture *texture)
+    {
+        auto &textures = s_sceneData.textures;
+
+        if (!texture->m_array)
         {
-            auto &count = s_sceneData.textures.count;
+            //? the format doesn't change and the budget only fills up, a rejected texture stays rejected
+            auto &arrays = s_sceneData.arrays;
+            if (texture->m_arrayRejected == arrays.generation)
+                return GetTextureSlot(texture);
+
+            auto size = texture->GetSize();
+            uint64_t key = (uint64_t(size.x) << 32) | uint32_t(size.y);
+            auto found = arrays.open.find(key);
+            TextureArray *current = found != arrays.open.end() ? found->second.get() : nullptr;
+
+            //? arrays grow with their layers, all of them share the budget
+            bool create = !current || current->IsFull();
+            size_t layerBytes = size_t(size.x) * size.y * 4;
+            size_t growth = create ? layerBytes * std::min(TextureArray::initialLayers, arrays.maxLayers) : current->GetGrowthBytes();
+
+            if (!TextureArray::CanHold(*texture) || arrays.allocatedBytes + growth > s_sceneData.settings.textureArrayBudget)
+            {
+                texture->m_arrayRejected = arrays.generation;
+                return GetTextureSlot(texture);
+            }
 
-            if (count >= s_sceneData.textures.slotLimit)
+            auto &array = arrays.open[key];
+            if (create)
             {
-                EndBatch();
-                s_sceneData.textures.usedTextures.clear();
+                array = TextureArray::Create(size, arrays.maxLayers);
+                arrays.all.push_back(array);
             }
 
-            bool &act = s_sceneData.textures.usedTextures[shape.GetTexture().get()];
+            uint32_t id = array->GetId();
+            array->AddLayer(*texture);
+            arrays.allocatedBytes += growth;
 
-            if (act)
+            if (array->GetId() != id && array->m_batchEpoch == textures.epoch)
             {
-                shape.SetTexId(shape.GetTexture()->GetSlot());
+                //? grew while bound in this batch, the queued quads read its unit at EndBatch
+                array->Bind(array->m_slot);
+                textures.boundTextures[array->m_slot] = array->GetId();
+                s_stats.textureBinds++;
             }
-            else
+        }
+
+        TextureArray *array = texture->m_array;
+
+        if (array->m_batchEpoch != textures.epoch)
+        {
+            if (textures.slotLimit + textures.arrayCount >= textures.unitCount)
             {
-                shape.GetTexture()->Upload(count);
-                act = true;
-                shape.SetTexId(count);
-                count++;
+                EndBatch();
+                s_stats.textureFlushes++;
+            }
+
+            uint32_t slot = textures.slotLimit + textures.arrayCount++;
+
+            if (textures.boundTextures[slot] != array->GetId())
+            {
+                array->Bind(slot);
+                textures.boundTextures[slot] = array->GetId();
+                s_stats.textureBinds++;
             }
+
+            array->m_slot = slot;
+            array->m_batchEpoch = textures.epoch;
         }
 
-        s_sceneData.queue.Add(shape);
+        //? high bit marks an array, low byte is the index into u_textureArrays, layer above it
+        return 0x80000000 | (texture->m_arrayLayer << 8) | (array->m_slot - textures.slotLimit);
     }
 
-    void Renderer2D::DrawQuad(Quad &shape, TransformComponent &transform)
+    uint32_t Renderer2D::GetBindlessTextureId(Texture *texture)
     {
-        CORE_PROFILE_FUNC();
+        if (texture->m_bindlessIndex < 0)
+        {
+            auto &bindless = s_sceneData.bindless;
+            texture->m_bindlessIndex = bindless.handles.size();
+            bindless.handles.push_back(texture->GetBindlessHandle());
+        }
 
-        if (s_sceneData.queue.m_objectCount >= Renderer2DQueue::quadsLimit)
-            EndBatch();
+        return texture->m_bindlessIndex;
+    }
+
+    void Renderer2D::UploadBindlessHandles()
+    {
+        auto &bindless = s_sceneData.bindless;
+
+        if (bindless.uploaded == bindless.handles.size())
+            return;
+
+        if (bindless.handles.size() > bindless.capacity)
+        {
+            //? queued draws may still read the old buffer, gl defers its deletion until they finish
+            if (bindless.buffer)
+                glDeleteBuffers(1, &bindless.buffer);
+
+            bindless.capacity = std::bit_ceil(bindless.handles.size());
+            glCreateBuffers(1, &bindless.buffer);
+            glNamedBufferStorage(bindless.buffer, bindless.capacity * sizeof(uint64_t), nullptr, GL_DYNAMIC_STORAGE_BIT);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, bindless.buffer);
+            bindless.uploaded = 0;
+        }
 
-        s_sceneData.queue.Add(shape, transform);
+        size_t count = bindless.handles.size() - bindless.uploaded;
+        glNamedBufferSubData(bindless.buffer, bindless.uploaded * sizeof(uint64_t), count * sizeof(uint64_t), &bindless.handles[bindless.uploaded]);
+        bindless.uploaded = bindless.handles.size();
     }
 
-    void Renderer2D::DrawTexturedQuad(Quad &shape, TransformComponent &transform, TextureComponent &textureComponent)
+    void Renderer2D::FlushIfFull(bool instancing)
     {
+        if (s_sceneData.queue.IsFull(instancing))
+            FlushFull();
+        else
+            SwitchStream(instancing);
+    }
 
-        if (s_sceneData.queue.m_objectCount >= Renderer2DQueue::quadsLimit)
+    void Renderer2D::SwitchStream(bool instancing)
+    {
+        //? EndBatch draws the vertex stream before the instance stream, a batch holding both would reorder
+        //? the quads, so switching between OldQuad and instanced submissions ends the batch
+        if (s_sceneData.queue.HoldsOtherStream(instancing))
             EndBatch();
+    }
+
+    void Renderer2D::FlushFull()
+    {
+        EndBatch();
+        s_sceneData.queue.m_capacityFlushed = true;
+    }
 
-        auto texture = textureComponent.Texture->GetTexture();
+    void Renderer2D::DrawQuad(OldQuad &shape)
+    {
+        if (s_sceneData.settings.sortedSubmission)
+        {
+            uint64_t key = MakeSortKey(shape.GetTexture().get(), shape.GetPosition().z, false);
+            s_sceneData.commands.commands.push_back({key, nullptr, nullptr, nullptr, &shape});
+            return;
+        }
 
-        auto &count = s_sceneData.textures.count;
+        SubmitOldQuad(shape);
+    }
 
-        if (count >= s_sceneData.textures.slotLimit)
+    void Renderer2D::SubmitOldQuad(OldQuad &shape)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        FlushIfFull(false);
+
+        if (shape.GetTexture())
+            shape.SetTexId(GetTextureSlot(shape.GetTexture().get()));
+
+        s_sceneData.queue.Add(shape);
+    }
+
+    void Renderer2D::DrawQuad(Quad &shape, TransformComponent &transform)
+    {
+        if (s_sceneData.settings.sortedSubmission)
         {
-            EndBatch();
-            s_sceneData.textures.usedTextures.clear();
+            uint64_t key = MakeSortKey(nullptr, transform.GetDepth(), s_sceneData.settings.instancing);
+            s_sceneData.commands.commands.push_back({key, &shape, &transform, nullptr, nullptr});
+            return;
         }
 
-        bool &act = s_sceneData.textures.usedTextures[texture.get()];
+        SubmitQuad(shape, transform);
+    }
 
-        if (act)
+    void Renderer2D::DrawTexturedQuad(Quad &shape, TransformComponent &transform, TextureComponent &textureComponent)
+    {
+        if (s_sceneData.settings.sortedSubmission)
         {
-            for (auto &vertex : shape.m_vertices)
-                vertex.textureId = float(texture->GetSlot()); //! todo
+            uint64_t key = MakeSortKey(textureComponent.Texture->GetTexture().get(), transform.GetDepth(), s_sceneData.settings.instancing);
+            s_sceneData.commands.commands.push_back({key, &shape, &transform, textureComponent.Texture.get(), nullptr});
+            return;
         }
+
+        SubmitTexturedQuad(shape, transform, *textureComponent.Texture);
+    }
+
+    void Renderer2D::SubmitQuad(Quad &shape, TransformComponent &transform)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        auto &queue = s_sceneData.queue;
+
+        bool instancing = s_sceneData.settings.instancing;
+        FlushIfFull(instancing);
+
+        if (instancing)
+            queue.AddInstance(shape, transform, 0);
         else
-        {
-            texture->Upload(count);
-            act = true;
+            queue.Add(shape, transform);
+    }
+
+    void Renderer2D::SubmitTexturedQuad(Quad &shape, TransformComponent &transform, SubTexture &texture)
+    {
+        FlushIfFull(s_sceneData.settings.instancing);
+        AddTexturedQuad(shape, transform, texture);
+    }
+
+    void Renderer2D::AddTexturedQuad(Quad &shape, TransformComponent &transform, SubTexture &texture)
+    {
+        auto &queue = s_sceneData.queue;
+        bool instancing = s_sceneData.settings.instancing;
 
-            for (auto &vertex : shape.m_vertices)
-                vertex.textureId = float(count);
-            count++;
+        auto coordinates = texture.GetCoordinateData();
+
+        if (instancing)
+        {
+            //? corners 1 and 3 hold the bottom left and top right of the region
+            uint32_t textureId = GetInstanceTextureId(texture.GetTexture().get());
+            queue.AddInstance(shape, transform, textureId, {coordinates[1], coordinates[3]});
+            return;
         }
 
+        uint32_t slot = GetTextureSlot(texture.GetTexture().get());
+
+        for (auto &vertex : shape.m_vertices)
+            vertex.textureId = float(slot);
+
         //? sets a subtexture coordinates
         for (size_t i = 0; i < shape.m_vertices.size(); i++)
-            shape.m_vertices[i].textureCoordinate = textureComponent.Texture->GetCoordinateData().at(i); 
+            shape.m_vertices[i].textureCoordinate = coordinates.at(i);
+
+        queue.Add(shape, transform);
+    }
+
+    void Renderer2D::SubmitQuadsParallel()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        auto &queue = s_sceneData.queue;
+        auto &entries = s_sceneData.parallelQuads;
+        bool instancing = s_sceneData.settings.instancing;
+        uint32_t minSlice = std::max(s_sceneData.settings.parallelMinQuads, 1u);
+
+        //? the vertex stream stays contiguous, quads still waiting in the main batch are written first
+        queue.FlushTransforms();
+        SwitchStream(instancing);
 
-        s_sceneData.queue.Add(shape, transform);
+        for (uint32_t next = 0; next < entries.size();)
+        {
+            if (queue.IsFull(instancing))
+                FlushFull();
+
+            uint32_t offset = instancing ? queue.m_instanceCount : queue.m_objectCount;
+            uint32_t count = std::min<uint32_t>(queue.m_quadsLimit - offset, entries.size() - next);
+            const Renderer2DQueue::QuadEntry *first = entries.data() + next;
+            std::atomic<uint32_t> recomputed = 0;
+
+            //? every slice writes its own range of the mapped region, ParallelFor returning is the join
+            JobSystem::ParallelFor(count, minSlice, [&](uint32_t begin, uint32_t end)
+                                   {
+                                       uint32_t sliceRecomputed = instancing
+                                           ? queue.WriteInstances(first + begin, end - begin, offset + begin)
+                                           : queue.WriteQuads(first + begin, end - begin, offset + begin);
+                                       recomputed.fetch_add(sliceRecomputed, std::memory_order_relaxed); });
+
+            if (instancing)
+            {
+                queue.m_instanceCount += count;
+            }
+            else
+            {
+                queue.m_objectCount += count;
+                queue.m_verticesCount += 4 * count;
+                queue.m_indicesCount += Quad::s_indices.size() * count;
+            }
+
+            queue.m_sceneQuadsCount += count;
+            s_stats.shapesCount += count;
+            s_stats.verticesCount += 4 * count;
+            s_stats.indicesCount += Quad::s_indices.size() * count;
+            s_stats.matricesRecomputed += recomputed.load(std::memory_order_relaxed);
+            next += count;
+        }
+    }
+
+    void Renderer2D::DrawArraysIndirect(Ref<Shader> &shader, uint32_t indirectBuffer, size_t offset)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        if (s_sceneData.settings.sortedSubmission)
+            FlushCommands();
+        EndBatch();
+
+        if (!s_sceneData.emptyVertexArray)
+            glCreateVertexArrays(1, &s_sceneData.emptyVertexArray);
+
+        glBindVertexArray(s_sceneData.emptyVertexArray);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        UploadViewProjection(shader);
+
+        {
+            CORE_PROFILE_DETAIL_CAT("Indirect draw call", Render);
+            glDrawArraysIndirect(GL_TRIANGLES, (const void *)offset);
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        glBindVertexArray(0);
+        s_stats.drawCallsCount++;
     }
 
     void Renderer2D::EndScene()
     {
+        if (s_sceneData.settings.sortedSubmission)
+            FlushCommands();
+
         EndBatch();
         FrameBuffer::BindDefault();
+        PublishMetrics();
+    }
+
+    void Renderer2D::BeginSortedSubmission()
+    {
+        auto &settings = s_sceneData.settings;
+        s_sceneData.commands.temporary = !settings.sortedSubmission;
+        settings.sortedSubmission = true;
+    }
+
+    void Renderer2D::EndSortedSubmission()
+    {
+        if (!s_sceneData.commands.temporary)
+            return; // sorted for the whole scene, EndScene flushes
+
+        FlushCommands();
+        s_sceneData.settings.sortedSubmission = false;
+        s_sceneData.commands.temporary = false;
+    }
+
+    void Renderer2D::PublishMetrics()
+    {
+        static auto &drawCalls = Metrics::GetCounter("render.draw calls");
+        static auto &batches = Metrics::GetCounter("render.batches");
+        static auto &vertices = Metrics::GetCounter("render.vertices");
+        static auto &quads = Metrics::GetCounter("render.quads");
+        static auto &textureBinds = Metrics::GetCounter("render.texture binds");
+        static auto &textureFlushes = Metrics::GetCounter("render.texture flushes");
+        static auto &bytesStreamed = Metrics::GetCounter("render.bytes streamed");
+        static auto &fenceStalls = Metrics::GetCounter("render.fence stalls");
+        static auto &quadsLimit = Metrics::GetGauge("render.batch quads limit");
+
+        //? Renderer2D::OnUpdate may have reset the stats since BeginScene, the whole scene is counted then
+        const RendererStats &start = s_stats.drawCallsCount >= s_sceneStart.drawCallsCount ? s_sceneStart : RendererStats{};
+
+        drawCalls.Add(s_stats.drawCallsCount - start.drawCallsCount);
+        batches.Add(s_stats.batchesCount - start.batchesCount);
+        vertices.Add(s_stats.verticesCount - start.verticesCount);
+        quads.Add(s_stats.shapesCount - start.shapesCount);
+        textureBinds.Add(s_stats.textureBinds - start.textureBinds);
+        textureFlushes.Add(s_stats.textureFlushes - start.textureFlushes);
+        bytesStreamed.Add(s_stats.bytesStreamed - start.bytesStreamed);
+        fenceStalls.Add(s_stats.fenceStalls - start.fenceStalls);
+        quadsLimit.Set(s_sceneData.queue.m_quadsLimit);
+        s_sceneStart = s_stats;
+    }
+
+    uint64_t Renderer2D::MakeSortKey(Texture *texture, float depth, bool instanced)
+    {
+        auto &data = s_sceneData.commands;
+        uint32_t depthBits = std::bit_cast<uint32_t>(depth);
+        depthBits ^= (depthBits & 0x80000000) ? 0xffffffff : 0x80000000; //? keeps float order for negative values
+
+        uint64_t textureKey = 0;
+
+        if (texture)
+        {
+            uint32_t id = texture->GetId();
+
+            if (id >= data.textureKeys.size())
+                data.textureKeys.resize(id + 1);
+
+            auto &entry = data.textureKeys[id];
+
+            if (entry.scene != data.scene)
+            {
+                CORE_ASSERT(data.nextTextureKey < (1u << 23), "Too many textures in one sorted scene!");
+                entry = {data.scene, data.nextTextureKey++};
+            }
+
+            textureKey = entry.key;
+        }
+
+        //? the stream decides the shader, quads of the vertex stream (OldQuad or no instancing) sort apart from instances
+        uint64_t layer = data.layer;
+        uint64_t stream = instanced ? 1 : 0;
+
+        return (layer << 56) | (stream << 55) | (textureKey << 32) | depthBits;
+    }
+
+    uint32_t Renderer2D::PredictTextureFlushes()
+    {
+        //? replays the slot allocation of GetTextureSlot over the submission order without touching gl
+        auto &data = s_sceneData.commands;
+        uint32_t flushes = 0;
+        uint32_t count = 1;
+        uint32_t quads = 0;
+        uint32_t stamp = ++data.stamp;
+
+        for (auto &command : data.commands)
+        {
+            if (quads >= s_sceneData.queue.m_quadsLimit)
+            {
+                stamp = ++data.stamp;
+                count = 1;
+                quads = 0;
+            }
+
+            if (Texture *texture = command.GetTexture())
+            {
+                uint32_t id = texture->GetId();
+
+                if (id >= data.textureStamps.size())
+                    data.textureStamps.resize(id + 1, 0);
+
+                if (data.textureStamps[id] != stamp)
+                {
+                    if (count >= s_sceneData.textures.slotLimit)
+                    {
+                        flushes++;
+                        stamp = ++data.stamp;
+                        count = 1;
+                        quads = 0;
+                    }
+
+                    data.textureStamps[id] = stamp;
+                    count++;
+                }
+            }
+
+            quads++;
+        }
+
+        return flushes;
+    }
+
+    void Renderer2D::FlushCommands()
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        auto &data = s_sceneData.commands;
+
+        if (data.commands.empty())
+            return;
+
+        uint32_t predictedFlushes = PredictTextureFlushes();
+        uint32_t flushesBefore = s_stats.textureFlushes;
+
+        {
+            CORE_PROFILE_SCOPE_CAT("Sort commands", Render);
+            RadixSort64(data.commands, data.scratch, [](const SceneData::CommandsData::Command &command)
+                        { return command.key; });
+        }
+
+        for (auto &command : data.commands)
+        {
+            if (command.oldQuad)
+                SubmitOldQuad(*command.oldQuad);
+            else if (command.texture)
+                SubmitTexturedQuad(*command.shape, *command.transform, *command.texture);
+            else
+                SubmitQuad(*command.shape, *command.transform);
+        }
+
+        uint32_t actualFlushes = s_stats.textureFlushes - flushesBefore;
+
+        if (predictedFlushes > actualFlushes)
+            s_stats.flushesAvoided += predictedFlushes - actualFlushes;
+
+        data.commands.clear();
+    }
+
+    void Renderer2D::UploadViewProjection(Ref<Shader> &shader)
+    {
+        shader->BindShader();
+        auto &uniform = shader->SetUniform("u_ViewProjectionMatrix");
+        uniform.SetAllowedDataType(Uniform::DataType::mat4f);
+        uniform = s_sceneData.camera->GetViewProjectionMatrix();
     }
 
     void Renderer2D::EndBatch()
     {
-        CORE_PROFILE_FUNC();
-        VertexArrayPrimitive vao;
+        CORE_PROFILE_FUNC_CAT(Render);
+        auto &queue = s_sceneData.queue;
+
+        //? SwitchStream keeps one of the streams empty, so the draw order is the submission order
+        if (queue.m_objectCount)
+        {
+            queue.FlushTransforms();
+            FenceQuadTransforms();
+
+            auto &stream = *queue.m_stream;
+            stream.Bind();
+            UploadViewProjection(s_sceneData.shader);
+
+            {
+                CORE_PROFILE_DETAIL_CAT("Draw call", Render);
+                glDrawElementsBaseVertex(GL_TRIANGLES, queue.m_indicesCount, GL_UNSIGNED_INT, nullptr, stream.GetBaseVertex());
+            }
 
-        vao.UploadData(s_sceneData.queue.GetData());
-        vao.GetIndexBuffer().UploadData(s_sceneData.queue.GetIdxData());
-        vao.SetLayout(Vertex::layout);
-        vao.Bind();
+            stream.Release();
+            s_stats.bytesStreamed += queue.m_verticesCount * sizeof(Vertex);
+            s_stats.drawCallsCount++;
+            s_stats.batchesCount++;
 
-        auto &shader = s_sceneData.shader->SetUniform("u_ViewProjectionMatrix");
-        shader.SetAllowedDataType(Uniform::DataType::mat4f);
-        shader = s_sceneData.camera->GetViewProjectionMatrix();
+            if (queue.MapVertices())
+                s_stats.fenceStalls++;
+        }
 
+        if (queue.m_instanceCount)
         {
-            CORE_PROFILE_SCOPE("Draw call");
-            glDrawElements(GL_TRIANGLES, vao.GetIndexBuffer().GetCount(), GL_UNSIGNED_INT, nullptr);
+            auto &stream = *queue.m_instanceStream;
+            stream.Bind();
+            UploadViewProjection(s_sceneData.instanceShader);
+
+            if (s_sceneData.settings.textureBackend == TextureBackend::Bindless)
+                UploadBindlessHandles();
+
+            {
+                CORE_PROFILE_DETAIL_CAT("Instanced draw call", Render);
+                glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, Quad::s_indices.size(), queue.m_instanceCount, stream.GetBaseInstance());
+            }
+
+            stream.Release();
+            s_stats.bytesStreamed += queue.m_instanceCount * sizeof(QuadInstance);
+            s_stats.drawCallsCount++;
+            s_stats.batchesCount++;
+
+            if (queue.MapInstances())
+                s_stats.fenceStalls++;
         }
 
-        s_sceneData.queue.m_objectCount = 0;
-        s_sceneData.queue.m_verticesCount = 0;
-        s_sceneData.queue.m_indicesCount = 0;
+        queue.m_objectCount = 0;
+        queue.m_verticesCount = 0;
+        queue.m_indicesCount = 0;
+        queue.m_instanceCount = 0;
         s_sceneData.textures.count = 1;
-        s_stats.drawCallsCount++;
+        s_sceneData.textures.arrayCount = 0;
+        s_sceneData.textures.epoch++;
     }
 
     void Renderer2D::DrawIndexed(Ref<Material> material, VertexArrayPrimitive &vertexArray)
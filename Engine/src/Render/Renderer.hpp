@@ -3,10 +3,13 @@
 #include "Graphics/Buffer.hpp"
 #include "Graphics/Shader.hpp"
 #include "Render/Primitive.hpp"
+#include "Render/QuadTransform.hpp"
 #include "Graphics/Texture.hpp"
+#include "Graphics/TextureArray.hpp"
 #include "Camera/Camera.hpp"
 #include "Graphics/FrameBuffer.hpp"
 #include "Scene/Components.hpp"
+#include "Core/JobSystem.hpp"
 namespace ant
 {
 
@@ -21,20 +24,77 @@ namespace ant
 
         void Add(OldQuad &shape);
         void Add(Quad &shape, TransformComponent& transform);
+        void AddInstance(const Quad &shape, TransformComponent &transform, uint32_t textureId, const glm::vec4 &atlasRect = {0.f, 0.f, 1.f, 1.f});
+        void FlushTransforms(); // writes the vertices of quads still waiting in m_transformBatch
+
+        //? untextured quads for the parallel path, each slice writes its own range of the mapped region
+        struct QuadEntry
+        {
+            Quad *shape;
+            TransformComponent *transform;
+        };
+        //! workers call these, they only touch the given entries and the output at offset
+        //! return the number of matrices recomputed
+        uint32_t WriteQuads(const QuadEntry *entries, uint32_t count, uint32_t offset);
+        uint32_t WriteInstances(const QuadEntry *entries, uint32_t count, uint32_t offset);
+        static void FillInstance(QuadInstance &instance, const Quad &shape, const TransformComponent &transform, uint32_t textureId, const glm::vec4 &atlasRect);
+
+        // both return true when mapping had to wait for the gpu
+        bool MapVertices();
+        bool MapInstances();
+
+        void Resize(uint32_t quadsLimit, bool instancing);
+        inline bool IsFull(bool instancing) const { return (instancing ? m_instanceCount : m_objectCount) >= m_quadsLimit; }
+        inline bool HoldsOtherStream(bool instancing) const { return instancing ? m_objectCount : m_instanceCount; }
 
-        std::pair<float *, size_t> GetData();
-        std::pair<uint32_t *, size_t> GetIdxData();
-   
     private:
         uint32_t m_objectCount = 0;
         uint32_t m_verticesCount = 0;
         uint32_t m_indicesCount = 0;
+        uint32_t m_instanceCount = 0;
+
+        uint32_t m_quadsLimit = 0;
+        uint32_t m_sceneQuadsCount = 0; // quads submitted since BeginScene, drives auto grow
+        bool m_capacityFlushed = false;
+
+        static constexpr uint32_t streamRegions = 3;
+        Ref<StreamVertexArray> m_stream;
+        Ref<StreamVertexArray> m_instanceStream;
+        Vertex *m_vertices = nullptr; //? points directly into the mapped stream region
+        QuadInstance *m_instances = nullptr;
+
+        //? Quad + TransformComponent vertices are reserved right away but transformed 8 quads at a time
+        QuadTransformBatch m_transformBatch;
+        const QuadTransformKernel &m_transformKernel = GetQuadTransformKernel();
+    };
+
+    enum class TextureBackend : uint8_t
+    {
+        Slots = 0, // one texture per unit, batches split at 32 textures
+        Arrays,    // same sized RGBA8 textures share one GL_TEXTURE_2D_ARRAY unit
+        Bindless   // ARB_bindless_texture handles, no per batch texture limit
+    };
+
+    struct Renderer2DSettings
+    {
+        bool instancing = true; //? Quad + TransformComponent draws upload one QuadInstance instead of 4 vertices
 
-        static constexpr size_t quadsLimit = 1000;   
-        using VertexStorage = std::array<Vertex, 4 * quadsLimit>;
-        using IndexStorage = std::array<uint32_t, 6 * quadsLimit>;
-        Ref<VertexStorage> m_vertices;
-        Ref<IndexStorage> m_indices;
+        uint32_t quadsLimit = 1000; // quads per batch
+        bool autoGrow = false;      //? grows the batch at BeginScene when the previous scene overflowed it
+        uint32_t maxQuadsLimit = 1 << 16; // also clamped by GL_MAX_ELEMENT_INDEX
+
+        //? DrawQuad and DrawTexturedQuad only record commands, EndScene sorts them by layer,
+        //? stream, texture and depth before batching so quads sharing textures end up together
+        bool sortedSubmission = false;
+
+        //? Arrays and Bindless only apply to instanced draws, Bindless falls back to Arrays without the extension
+        TextureBackend textureBackend = TextureBackend::Slots;
+        size_t textureArrayBudget = 64 << 20; // bytes all texture arrays may allocate together, textures past it keep a plain unit
+
+        //? DrawQuads transforms big ranges on the JobSystem workers, needs JobSystem::Init
+        //? only untextured quads outside of sorted submission go wide, texture slots are bound on the main thread
+        bool parallelQuads = false;
+        uint32_t parallelMinQuads = 2048; // per job, smaller ranges are not worth waking the workers
     };
 
     class Renderer2D
@@ -45,17 +105,77 @@ namespace ant
         struct SceneData
         {
             Ref<Shader> shader = Shader::Create("shaders/Shader.glsl");
-            // Ref<Shader> shader;
+            Ref<Shader> instanceShader;
+            Renderer2DSettings settings;
+            uint32_t maxQuadsLimit;
             Ref<OrthographicCamera> camera; 
             Ref<Texture> defaultTexture;
             Renderer2DQueue queue;
+            std::vector<Renderer2DQueue::QuadEntry> parallelQuads; // gathered by DrawQuads, reused between scenes
+            uint32_t emptyVertexArray = 0; // bound for draws whose shader pulls its own vertices
 
             struct TexturesData
             {
+                static constexpr uint32_t unitCount = 32;
+                uint32_t slotLimit = unitCount; // units for plain textures, the rest is left for texture arrays
                 uint32_t count = 1;
-                uint32_t slotLimit = 32;
-                std::unordered_map<Texture *, bool> usedTextures;
+                uint32_t arrayCount = 0;
+                uint32_t epoch = 1; //? bumped by every EndBatch, textures stamped with it are in the current batch
+                std::array<uint32_t, unitCount> boundTextures{}; // texture (or array) id held by each unit, survives batches
             } textures;
+
+            struct TextureArraysData
+            {
+                std::unordered_map<uint64_t, Ref<TextureArray>> open; // by size, array that takes new textures
+                std::vector<Ref<TextureArray>> all;
+                uint32_t maxLayers = 0;
+                size_t allocatedBytes = 0; // counted against textureArrayBudget
+                uint32_t generation = 1; // bumped by Init, textures rejected under an older one are asked again
+            } arrays;
+
+            struct BindlessData
+            {
+                std::vector<uint64_t> handles;
+                uint32_t buffer = 0; // shader storage buffer mirroring handles
+                size_t capacity = 0;
+                size_t uploaded = 0;
+            } bindless;
+
+            struct CommandsData
+            {
+                struct Command
+                {
+                    uint64_t key; // layer 8 | stream 1 | texture 23 | depth 32
+                    Quad *shape;  //! recorded by pointer, has to stay alive until EndScene
+                    TransformComponent *transform;
+                    SubTexture *texture;
+                    OldQuad *oldQuad; // DrawQuad(OldQuad&), shape and transform are null then
+
+                    inline Texture *GetTexture() const
+                    {
+                        if (texture)
+                            return texture->GetTexture().get();
+                        return oldQuad ? oldQuad->GetTexture().get() : nullptr;
+                    }
+                };
+
+                //? textures are keyed by the order they first show up in the scene, ids grow for the whole run
+                struct TextureKey
+                {
+                    uint32_t scene = 0;
+                    uint32_t key = 0;
+                };
+
+                std::vector<Command> commands;
+                std::vector<Command> scratch;
+                std::vector<uint32_t> textureStamps; // per texture id, used to predict flushes of the submission order
+                std::vector<TextureKey> textureKeys; // per texture id
+                uint32_t stamp = 0;
+                uint32_t scene = 0;
+                uint32_t nextTextureKey = 1; // 0 is untextured
+                uint8_t layer = 0;
+                bool temporary = false; // sortedSubmission was turned on by BeginSortedSubmission
+            } commands;
         };
         struct RendererStats
         {
@@ -63,6 +183,13 @@ namespace ant
             uint32_t shapesCount = 0;
             uint32_t verticesCount = 0;
             uint32_t indicesCount = 0;
+            size_t bytesStreamed = 0;
+            uint32_t fenceStalls = 0;
+            uint32_t textureFlushes = 0;
+            uint32_t flushesAvoided = 0; // texture flushes saved by sorted submission
+            uint32_t matricesRecomputed = 0; // dirty transforms rebuilt while drawing, 0 for a static scene
+            uint32_t batchesCount = 0;       // draw calls of the quad batches
+            uint32_t textureBinds = 0;       // units rebound, redundant binds are filtered
 
             void Reset()
             {
@@ -70,11 +197,18 @@ namespace ant
                 shapesCount = 0;
                 verticesCount = 0;
                 indicesCount = 0;
+                bytesStreamed = 0;
+                fenceStalls = 0;
+                textureFlushes = 0;
+                flushesAvoided = 0;
+                matricesRecomputed = 0;
+                batchesCount = 0;
+                textureBinds = 0;
             }
         };
 
     public:
-        static void Init();
+        static void Init(const Renderer2DSettings &settings = {});
         static void OnUpdate();
         static void BeginScene(Ref<OrthographicCamera> camera, Ref<FrameBuffer> drawTarget = nullptr);
 
@@ -83,21 +217,166 @@ namespace ant
         static void DrawQuad(Quad &shape, TransformComponent& transform);
         static void DrawTexturedQuad(Quad &shape, TransformComponent& transform, TextureComponent& texture);
 
+        //? bulk versions for Scene::OnRender, range.each() has to yield (Quad&, TransformComponent&)
+        //? or (TextureComponent&, Quad&, TransformComponent&) like the entt groups of the scene
+        //? quads go straight to the queue, only the capacity check is left per quad
+        template <class Range>
+        static void DrawQuads(Range &range);
+        template <class Range>
+        static void DrawTexturedQuads(Range &range);
+
+        //? writes count untextured quads straight into the instance stream, batches are flushed in between
+        //? fill(out, first, n) fills out[0, n) with quads first to first + n, n is at most the free batch space
+        //? with sorted submission the commands recorded so far are sorted and flushed first, they draw before these
+        //! needs settings.instancing
+        template <class Fn>
+        static void DrawInstances(uint32_t count, Fn &&fill);
+
+        //? one draw whose arguments were written by the gpu, DrawArraysIndirectCommand at offset in indirectBuffer
+        //? no vertex attributes are bound, the shader has to pull its vertices from storage buffers
+        //? flushes the recorded commands of sorted submission and the pending batch first, so it draws after them
+        static void DrawArraysIndirect(Ref<Shader> &shader, uint32_t indirectBuffer, size_t offset);
+
         static void EndScene();
 
+        //? draws in between take the sorted submission path even when settings.sortedSubmission is off,
+        //? EndSortedSubmission sorts and flushes them, for a frame whose draw order isn't known up front
+        static void BeginSortedSubmission();
+        static void EndSortedSubmission();
+
+        static void SetSortLayer(uint8_t layer) { s_sceneData.commands.layer = layer; } // most significant part of the sort key
+
         static void DrawIndexed(Ref<Material> material, VertexArrayPrimitive &vertexArray);
         static void DrawIndexed(Ref<Shader> shader, VertexArrayPrimitive &vertexArray);
 
         static RendererStats GetStats() { return s_stats; }
+        static const Renderer2DSettings &GetSettings() { return s_sceneData.settings; }
+        static uint32_t GetQuadsLimit() { return s_sceneData.queue.m_quadsLimit; }
 
     private:
         Renderer2D() {}
         ~Renderer2D() {} 
         static void EndBatch();
+        static void FlushIfFull(bool instancing); // also ends the batch when the other stream holds quads
+        static void SwitchStream(bool instancing);
+        static void FlushFull();
+
+        static void SubmitQuad(Quad &shape, TransformComponent &transform);
+        static void SubmitTexturedQuad(Quad &shape, TransformComponent &transform, SubTexture &texture);
+        static void AddTexturedQuad(Quad &shape, TransformComponent &transform, SubTexture &texture); // SubmitTexturedQuad without the capacity check
+        static void SubmitQuadsParallel(); // writes s_sceneData.parallelQuads across the JobSystem workers
+
+        static void SubmitOldQuad(OldQuad &shape);
+
+        static uint64_t MakeSortKey(Texture *texture, float depth, bool instanced);
+        static uint32_t PredictTextureFlushes();
+        static void FlushCommands();
+        static void UploadViewProjection(Ref<Shader> &shader);
+        static uint32_t GetTextureSlot(Texture *texture);
+        static uint32_t GetInstanceTextureId(Texture *texture);
+        static uint32_t GetArrayTextureId(Texture *texture);
+        static uint32_t GetBindlessTextureId(Texture *texture);
+        static void UploadBindlessHandles();
+        static void PublishMetrics(); // the stats of the scene into Metrics, from the thread that drew it
 
     private:
         static SceneData s_sceneData;
         static RendererStats s_stats;
+        static RendererStats s_sceneStart; // s_stats at BeginScene
     };
 
+    template <class Range>
+    void Renderer2D::DrawQuads(Range &range)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        if (s_sceneData.settings.sortedSubmission)
+        {
+            range.each([](Quad &shape, TransformComponent &transform)
+                       { DrawQuad(shape, transform); });
+            return;
+        }
+
+        if (s_sceneData.settings.parallelQuads && JobSystem::IsRunning() && range.size() >= 2 * s_sceneData.settings.parallelMinQuads)
+        {
+            //? one pass gathering pointers, then the slices split the transforms between threads
+            auto &entries = s_sceneData.parallelQuads;
+            entries.clear();
+            range.each([&](Quad &shape, TransformComponent &transform)
+                       { entries.push_back({&shape, &transform}); });
+            SubmitQuadsParallel();
+            return;
+        }
+
+        auto &queue = s_sceneData.queue;
+        bool instancing = s_sceneData.settings.instancing;
+        SwitchStream(instancing);
+
+        if (instancing)
+        {
+            range.each([&](Quad &shape, TransformComponent &transform)
+                       {
+                           if (queue.IsFull(true))
+                               FlushFull();
+                           queue.AddInstance(shape, transform, 0); });
+        }
+        else
+        {
+            range.each([&](Quad &shape, TransformComponent &transform)
+                       {
+                           if (queue.IsFull(false))
+                               FlushFull();
+                           queue.Add(shape, transform); });
+        }
+    }
+
+    template <class Range>
+    void Renderer2D::DrawTexturedQuads(Range &range)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        if (s_sceneData.settings.sortedSubmission)
+        {
+            range.each([](TextureComponent &texture, Quad &shape, TransformComponent &transform)
+                       { DrawTexturedQuad(shape, transform, texture); });
+            return;
+        }
+
+        auto &queue = s_sceneData.queue;
+        bool instancing = s_sceneData.settings.instancing;
+        SwitchStream(instancing);
+
+        range.each([&](TextureComponent &texture, Quad &shape, TransformComponent &transform)
+                   {
+                       if (queue.IsFull(instancing))
+                           FlushFull();
+                       AddTexturedQuad(shape, transform, *texture.Texture); });
+    }
+
+    template <class Fn>
+    void Renderer2D::DrawInstances(uint32_t count, Fn &&fill)
+    {
+        CORE_PROFILE_FUNC_CAT(Render);
+        CORE_ASSERT(s_sceneData.settings.instancing, "Renderer2D::DrawInstances needs instancing!");
+        if (s_sceneData.settings.sortedSubmission)
+            FlushCommands(); // the recorded quads keep their place in the submission order
+
+        auto &queue = s_sceneData.queue;
+        SwitchStream(true);
+
+        for (uint32_t next = 0; next < count;)
+        {
+            if (queue.IsFull(true))
+                FlushFull();
+
+            uint32_t n = std::min(queue.m_quadsLimit - queue.m_instanceCount, count - next);
+            fill(queue.m_instances + queue.m_instanceCount, next, n);
+
+            queue.m_instanceCount += n;
+            queue.m_sceneQuadsCount += n;
+            s_stats.shapesCount += n;
+            s_stats.verticesCount += 4 * n;
+            s_stats.indicesCount += Quad::s_indices.size() * n;
+            next += n;
+        }
+    }
+
 } // namespace ant
@@ -7,15 +7,29 @@
 
 namespace ant
 {
-    bool RendererCommands::InitGlfw()
+    bool RendererCommands::InitGlfw(RenderBackend backend)
     {
         static bool initialized = false;
         if (!initialized)
         {
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+            //? no display server needed, older glfw opens the hidden window on the native platform
+            if (backend == RenderBackend::Offscreen)
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
             CORE_ASSERT(glfwInit(), "Failed to initialize GLFW ");
             glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
             glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
             glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+            if (backend == RenderBackend::Offscreen)
+            {
+                //? llvmpipe stops at 4.5, the engine needs no more than the direct state access of 4.5
+                glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+                glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            }
+
             stbi_set_flip_vertically_on_load(true);
             initialized = true;
         }
@@ -34,19 +48,37 @@ namespace ant
 
     void RendererCommands::Clear()
     {
-        CORE_PROFILE_FUNC();
+        CORE_PROFILE_FUNC_CAT(Render);
         glClear(GL_COLOR_BUFFER_BIT);
         glClear(GL_DEPTH_BUFFER_BIT);
         glClear(GL_STENCIL_BUFFER_BIT);
     }
 
-    bool RendererCommands::InitGlew()
+    void RendererCommands::SetViewport(glm::ivec2 size)
+    {
+        glViewport(0, 0, size.x, size.y);
+    }
+
+    bool RendererCommands::InitGlew(RenderBackend backend)
     {
         static bool initialized = false;
         if (!initialized)
         {
             GLenum glewInitState = glewInit();
-            CORE_ASSERT(glewInitState == GLEW_OK, "Failed to initialize glew");
+
+            if (backend == RenderBackend::Offscreen)
+            {
+                //? glew loads through glx, which knows nothing of an osmesa or a surfaceless egl context
+                //? the entry points come from the context itself, GLEW_ flags glew couldn't set stay off and the renderer takes its fallbacks
+                if (glewInitState != GLEW_OK)
+                    CORE_WARN("glew can't load the offscreen context: {0}", (const char *)glewGetErrorString(glewInitState));
+
+                gl::LoadEntryPoints(&glfwGetProcAddress);
+                CORE_INFO("Offscreen OpenGL {0}", (const char *)glGetString(GL_VERSION));
+            }
+            else
+                CORE_ASSERT(glewInitState == GLEW_OK, "Failed to initialize glew");
+
             initialized = true;
         }
         return initialized;
@@ -1,5 +1,7 @@
 #pragma once
 #include <glm/vec4.hpp>
+#include <glm/vec2.hpp>
+#include "Render/RenderBackend.hpp"
 namespace ant
 {
 
@@ -10,12 +12,13 @@ namespace ant
         ~RendererCommands() {}
 
     public:
-        static bool InitGlfw();
-        static bool InitGlew();
+        static bool InitGlfw(RenderBackend backend = RenderBackend::Native);
+        static bool InitGlew(RenderBackend backend = RenderBackend::Native); //! with the context current
         static bool ShutdownGlfw();
 
         static void SetClearColor(glm::vec4 color);
         static void Clear();
+        static void SetViewport(glm::ivec2 size);
 
         static bool EnableGlDebugMessages();
 
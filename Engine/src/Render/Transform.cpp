@@ -2,16 +2,64 @@
 #include "Render/Transform.hpp"
 
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
 
 namespace ant
 {
-    void TransformComponent::CalculateTranformationMatrix()
+    std::atomic<uint32_t> TransformComponent::s_nextVersion = 1;
+
+    bool TransformComponent::CalculateTranformationMatrix()
+    {
+        if (!m_dirty)
+            return false;
+
+        CORE_PROFILE_FUNC_CAT(Scene);
+        //? same as translate * rotate(-rotation) * scale, written out instead of multiplying three matrices
+        float sine = std::sin(m_rotation);
+        float cosine = std::cos(m_rotation);
+
+        glm::mat2 linear(cosine * m_scale.x, -sine * m_scale.x,
+                         sine * m_scale.y, cosine * m_scale.y);
+        glm::vec2 translation(m_translation);
+        float depth = m_translation.z;
+
+        if (m_hasParent)
+        {
+            glm::mat2 parentLinear(m_parentAffine[0], m_parentAffine[1]);
+            linear = parentLinear * linear;
+            translation = parentLinear * translation + m_parentAffine[2];
+            depth += m_parentDepth;
+        }
+
+        m_affine = glm::mat3x2(linear[0], linear[1], translation);
+
+        m_trs = glm::mat4(linear[0][0], linear[0][1], 0.f, 0.f,
+                          linear[1][0], linear[1][1], 0.f, 0.f,
+                          0.f, 0.f, 1.f, 0.f,
+                          translation.x, translation.y, depth, 1.f);
+
+        m_version = s_nextVersion.fetch_add(1, std::memory_order_relaxed);
+        m_dirty = false;
+        return true;
+    }
+
+    void TransformComponent::SetParent(const TransformComponent *parent)
     {
-        CORE_PROFILE_FUNC();
-        m_trs = glm::translate(glm::mat4(1.f), m_translation) *
-                glm::rotate(glm::mat4(1.f),-m_rotation, glm::vec3(0.f, 0.f, 1.f)) *
-                glm::scale(glm::mat4(1.f), glm::vec3(m_scale.x, m_scale.y, 1.f));
+        if (!parent)
+        {
+            m_dirty |= m_hasParent;
+            m_hasParent = false;
+            return;
+        }
+
+        if (m_hasParent && m_parentVersion == parent->m_version)
+            return;
+
+        m_parentAffine = parent->m_affine;
+        m_parentDepth = parent->GetDepth();
+        m_parentVersion = parent->m_version;
+        m_hasParent = true;
+        m_dirty = true;
     }
   
 } // namespace ant
\ No newline at end of file
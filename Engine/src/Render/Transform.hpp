@@ -1,6 +1,9 @@
 #pragma once
 #include <glm/vec3.hpp>
+#include <glm/mat3x2.hpp>
 #include <glm/mat4x4.hpp>
+#include <atomic>
+#include <vector>
 
 namespace ant
 {
@@ -8,26 +11,64 @@ namespace ant
     {
     public:
         TransformComponent()
-            : m_trs(1.f), m_rotation(0.f), m_scale(1.f), m_translation(0.f,0.f, 0.f){}
+            : m_trs(1.f), m_affine(1.f), m_rotation(0.f), m_scale(1.f), m_translation(0.f,0.f, 0.f){}
 
         virtual ~TransformComponent() {}
 
-        void CalculateTranformationMatrix();
-        const glm::mat4 &GetTransformationMatrix() const { return m_trs; }
+        //? rebuilds the cached matrices only after a setter or the parent changed something, returns true when it did
+        bool CalculateTranformationMatrix();
+        const glm::mat4 &GetTransformationMatrix() const { return m_trs; } // world space
+        const glm::mat3x2 &GetAffine() const { return m_affine; } // 2D part of m_trs: x axis, y axis, translation
+        //? world z from the local one and the pulled parent, valid before CalculateTranformationMatrix
+        inline float GetDepth() const { return m_hasParent ? m_parentDepth + m_translation.z : m_translation.z; }
+        inline bool IsDirty() const { return m_dirty; }
 
-        inline  glm::vec2 GetScale() { return m_scale; }
-        inline float GetRotation() { return m_rotation; }
-        inline const glm::vec3 &GetPosition() { return m_translation; }
+        //? world = parent world * local, pulled again only when the parent was recalculated since the last call
+        //! parent has to be up to date, Scene::UpdateTransforms calls this in parent before child order
+        void SetParent(const TransformComponent *parent);
 
-        inline void SetScale(const glm::vec2& scale) { m_scale = scale; }
-        inline void SetRotation(float rotation) { m_rotation = rotation; }
-        inline void SetPosition(const glm::vec3 &trans) { m_translation = trans; }
+        inline  glm::vec2 GetScale() const { return m_scale; }
+        inline float GetRotation() const { return m_rotation; }
+        inline const glm::vec3 &GetPosition() const { return m_translation; }
+
+        //! a hooked transform (SetDirtyQueue) may only be changed on the thread running Scene::OnRender,
+        //! the first change after a recalculation pushes into the scene queue, which takes no lock
+        inline void SetScale(const glm::vec2& scale) { m_scale = scale; MarkDirty(); }
+        inline void SetRotation(float rotation) { m_rotation = rotation; MarkDirty(); }
+        inline void SetPosition(const glm::vec3 &trans) { m_translation = trans; MarkDirty(); }
+
+        //? Scene hooks the transforms of its hierarchy, the first change after a recalculation queues owner
+        //? so Scene::UpdateTransforms only walks the subtrees below changed nodes
+        //! copies keep the queue, only the scene storage should hold hooked transforms
+        //! the queue is a plain vector, jobs may only modify transforms that are not hooked
+        inline void SetDirtyQueue(std::vector<uint32_t> *queue, uint32_t owner) { m_dirtyQueue = queue; m_owner = owner; }
+
+    private:
+        inline void MarkDirty()
+        {
+            if (!m_dirty && m_dirtyQueue)
+                m_dirtyQueue->push_back(m_owner);
+            m_dirty = true;
+        }
 
     private:
         glm::vec3 m_translation;
         float m_rotation;
         glm::vec2 m_scale;
         glm::mat4 m_trs;
+        glm::mat3x2 m_affine;
+        bool m_dirty = true;
+
+        glm::mat3x2 m_parentAffine = glm::mat3x2(1.f);
+        float m_parentDepth = 0.f;
+        bool m_hasParent = false;
+        uint32_t m_parentVersion = 0;
+        uint32_t m_version = 0; // unique among all transforms, changes with every recalculation
+
+        std::vector<uint32_t> *m_dirtyQueue = nullptr;
+        uint32_t m_owner = 0;
+
+        static std::atomic<uint32_t> s_nextVersion; //? atomic, Renderer2D worker threads recalculate transforms too
     };
 
-} // namespace ant
\ No newline at end of file
+} // namespace ant
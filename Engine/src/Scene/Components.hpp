@@ -2,6 +2,7 @@
 #include "Render/Primitive.hpp"
 #include <glm/vec4.hpp>
 #include "Graphics/Texture.hpp"
+#include <entt/entity/entity.hpp>
 
 #include "Render/Transform.hpp" //! Trabsform component
 
@@ -24,4 +25,15 @@ namespace ant
         Ref<SubTexture> Texture;
     };
 
+    //? intrusive child list, maintained by Entity::SetParent, depth orders the storage for Scene::UpdateTransforms
+    struct RelationshipComponent
+    {
+        entt::entity Parent = entt::null;
+        entt::entity FirstChild = entt::null;
+        entt::entity PrevSibling = entt::null;
+        entt::entity NextSibling = entt::null;
+        uint32_t ChildrenCount = 0;
+        uint32_t Depth = 0; // 0 for roots
+    };
+
 }
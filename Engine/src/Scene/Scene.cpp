@@ -1,10 +1,321 @@
 #include "Pch.h"
 #include "Scene/Scene.hpp"
+#include "Scene/Components.hpp"
+#include "Render/Renderer.hpp"
+#include "debug/Metrics.hpp"
+#include <algorithm>
+#include <limits>
 
 namespace ant
 {
+    Scene::Scene()
+    {
+        m_registry.on_destroy<RelationshipComponent>().connect<&Scene::OnRelationshipDestroyed>(this);
+        m_registry.on_construct<TransformComponent>().connect<&Scene::OnTransformConstructed>(this);
+    }
+
+    Scene::~Scene()
+    {
+        m_registry.on_destroy<RelationshipComponent>().disconnect(this);
+        m_registry.on_construct<TransformComponent>().disconnect(this);
+    }
+
     Entity Scene::RegisterEntity()
     {
         return {this, m_registry.create()};
     }
-}
\ No newline at end of file
+
+    void Entity::SetParent(Entity parent)
+    {
+        CORE_ASSERT(parent.m_sceneRef == m_sceneRef, "Parent belongs to a different scene!");
+        m_sceneRef->SetParent(m_entityId, parent.m_entityId);
+    }
+
+    void Entity::RemoveParent()
+    {
+        m_sceneRef->SetParent(m_entityId, entt::null);
+    }
+
+    void Scene::SetParent(entt::entity child, entt::entity parent)
+    {
+        CORE_PROFILE_FUNC_CAT(Scene);
+        CORE_ASSERT(child != parent, "Entity can not be its own parent!");
+
+        //? emplace first, adding to the storage may move the components referenced below
+        m_registry.get_or_emplace<RelationshipComponent>(child);
+        if (parent != entt::null)
+            m_registry.get_or_emplace<RelationshipComponent>(parent);
+
+        HookTransform(child);
+        if (parent != entt::null)
+            HookTransform(parent);
+
+        auto &relation = m_registry.get<RelationshipComponent>(child);
+
+        if (relation.Parent != entt::null)
+        {
+            auto &oldParent = m_registry.get<RelationshipComponent>(relation.Parent);
+
+            if (oldParent.FirstChild == child)
+                oldParent.FirstChild = relation.NextSibling;
+            if (relation.PrevSibling != entt::null)
+                m_registry.get<RelationshipComponent>(relation.PrevSibling).NextSibling = relation.NextSibling;
+            if (relation.NextSibling != entt::null)
+                m_registry.get<RelationshipComponent>(relation.NextSibling).PrevSibling = relation.PrevSibling;
+
+            oldParent.ChildrenCount--;
+            relation.PrevSibling = entt::null;
+            relation.NextSibling = entt::null;
+        }
+
+        relation.Parent = parent;
+        uint32_t depth = 0;
+
+        if (parent != entt::null)
+        {
+            auto &newParent = m_registry.get<RelationshipComponent>(parent);
+
+            for (auto ancestor = parent; ancestor != entt::null; ancestor = m_registry.get<RelationshipComponent>(ancestor).Parent)
+                CORE_ASSERT(ancestor != child, "Parenting would create a cycle!");
+
+            relation.NextSibling = newParent.FirstChild;
+            if (newParent.FirstChild != entt::null)
+                m_registry.get<RelationshipComponent>(newParent.FirstChild).PrevSibling = child;
+
+            newParent.FirstChild = child;
+            newParent.ChildrenCount++;
+            depth = newParent.Depth + 1;
+        }
+
+        UpdateDepth(child, depth);
+        m_hierarchyChanged = true;
+    }
+
+    void Scene::UpdateDepth(entt::entity entity, uint32_t depth)
+    {
+        //? explicit stack, deep chains would overflow a recursive walk
+        m_registry.get<RelationshipComponent>(entity).Depth = depth;
+        std::vector<entt::entity> pending = {entity};
+
+        while (!pending.empty())
+        {
+            auto &relation = m_registry.get<RelationshipComponent>(pending.back());
+            pending.pop_back();
+
+            for (auto child = relation.FirstChild; child != entt::null;)
+            {
+                auto &childRelation = m_registry.get<RelationshipComponent>(child);
+                childRelation.Depth = relation.Depth + 1;
+                pending.push_back(child);
+                child = childRelation.NextSibling;
+            }
+        }
+    }
+
+    void Scene::HookTransform(entt::entity entity)
+    {
+        if (auto transform = m_registry.try_get<TransformComponent>(entity))
+            transform->SetDirtyQueue(&m_dirtyTransforms, entt::to_integral(entity));
+    }
+
+    void Scene::OnTransformConstructed(entt::registry &registry, entt::entity entity)
+    {
+        if (!registry.all_of<RelationshipComponent>(entity))
+            return;
+
+        HookTransform(entity);
+        m_hierarchyChanged = true;
+    }
+
+    void Scene::OnRelationshipDestroyed(entt::registry &registry, entt::entity entity)
+    {
+        //? runs before the component is removed, every link to the node is cut here so no id dangles
+        auto &relation = registry.get<RelationshipComponent>(entity);
+
+        while (relation.FirstChild != entt::null)
+            SetParent(relation.FirstChild, relation.Parent);
+
+        SetParent(entity, entt::null);
+
+        if (auto transform = registry.try_get<TransformComponent>(entity))
+            transform->SetDirtyQueue(nullptr, 0);
+    }
+
+    void Scene::OnRender()
+    {
+        CORE_PROFILE_FUNC_CAT(Scene);
+        static auto &sprites = Metrics::GetCounter("scene.sprites");
+        static auto &transforms = Metrics::GetCounter("scene.transforms recomputed");
+
+        transforms.Add(UpdateTransforms());
+
+        //? the groups own different components so they can coexist, sprites (and textures) are packed at the
+        //? front of their storage, transforms are fetched through the sparse set
+        auto plainSprites = m_registry.group<SpriteRenderComponent>(entt::get<TransformComponent>, entt::exclude<TextureComponent>);
+        auto texturedSprites = m_registry.group<TextureComponent>(entt::get<SpriteRenderComponent, TransformComponent>);
+
+        //? blending needs far quads first, sorted submission orders by depth on its own,
+        //? otherwise the group lying further back is drawn first, interleaving groups are sorted for this frame
+        bool texturedFirst = false;
+        bool interleaved = false;
+        if (!Renderer2D::GetSettings().sortedSubmission && !plainSprites.empty() && !texturedSprites.empty())
+        {
+            CORE_PROFILE_SCOPE_CAT("Depth ranges", Scene);
+            auto plain = DepthRange(plainSprites);
+            auto textured = DepthRange(texturedSprites);
+
+            texturedFirst = textured.max <= plain.min && textured.max < plain.max;
+            interleaved = !texturedFirst && plain.max > textured.min;
+        }
+
+        if (interleaved)
+        {
+            static bool warned = false;
+            if (!warned)
+            {
+                CORE_WARN("Textured and untextured sprites interleave in depth, they are sorted every frame, consider Renderer2DSettings::sortedSubmission");
+                warned = true;
+            }
+
+            Renderer2D::BeginSortedSubmission();
+            Renderer2D::DrawQuads(plainSprites);
+            Renderer2D::DrawTexturedQuads(texturedSprites);
+            Renderer2D::EndSortedSubmission();
+        }
+        else if (texturedFirst)
+        {
+            Renderer2D::DrawTexturedQuads(texturedSprites);
+            Renderer2D::DrawQuads(plainSprites);
+        }
+        else
+        {
+            Renderer2D::DrawQuads(plainSprites);
+            Renderer2D::DrawTexturedQuads(texturedSprites);
+        }
+
+        sprites.Add(plainSprites.size() + texturedSprites.size());
+    }
+
+    template <class Group>
+    Scene::DepthBounds Scene::DepthRange(Group &group)
+    {
+        DepthBounds bounds{std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()};
+
+        for (auto entity : group)
+        {
+            float depth = group.template get<TransformComponent>(entity).GetDepth();
+            bounds.min = std::min(bounds.min, depth);
+            bounds.max = std::max(bounds.max, depth);
+        }
+
+        return bounds;
+    }
+
+    uint32_t Scene::UpdateTransforms()
+    {
+        CORE_PROFILE_FUNC_CAT(Scene);
+        uint32_t recomputed;
+
+        if (m_hierarchyChanged)
+        {
+            {
+                CORE_PROFILE_SCOPE_CAT("Sort hierarchy", Scene);
+                //? depth first keeps parents ahead of children, siblings stay next to each other
+                m_registry.sort<RelationshipComponent>([](const RelationshipComponent &l, const RelationshipComponent &r)
+                                                       { return l.Depth != r.Depth ? l.Depth < r.Depth : entt::to_integral(l.Parent) < entt::to_integral(r.Parent); });
+                m_registry.sort<TransformComponent, RelationshipComponent>();
+            }
+
+            m_hierarchyChanged = false;
+            recomputed = UpdateAllTransforms();
+        }
+        else
+            recomputed = UpdateDirtyTransforms();
+
+        m_dirtyTransforms.clear();
+        return recomputed;
+    }
+
+    uint32_t Scene::UpdateAllTransforms()
+    {
+        //? clean nodes under a clean parent only cost a version compare
+        auto view = m_registry.view<RelationshipComponent>();
+        uint32_t recomputed = 0;
+
+        for (auto entity : view)
+        {
+            auto transform = m_registry.try_get<TransformComponent>(entity);
+            if (!transform)
+                continue;
+
+            auto &relation = view.get<RelationshipComponent>(entity);
+            transform->SetParent(relation.Parent != entt::null ? m_registry.try_get<TransformComponent>(relation.Parent) : nullptr);
+            recomputed += transform->CalculateTranformationMatrix();
+        }
+
+        return recomputed;
+    }
+
+    uint32_t Scene::UpdateDirtyTransforms()
+    {
+        //? shallow nodes first, a dirty node below them is already clean once its turn comes
+        std::vector<std::pair<uint32_t, entt::entity>> dirty;
+        dirty.reserve(m_dirtyTransforms.size());
+
+        for (uint32_t id : m_dirtyTransforms)
+        {
+            auto entity = entt::entity(id);
+            if (!m_registry.valid(entity))
+                continue;
+
+            if (auto relation = m_registry.try_get<RelationshipComponent>(entity))
+                dirty.push_back({relation->Depth, entity});
+        }
+
+        std::sort(dirty.begin(), dirty.end(), [](const auto &l, const auto &r)
+                  { return l.first < r.first; });
+
+        uint32_t recomputed = 0;
+
+        for (auto [depth, entity] : dirty)
+        {
+            //? also when the node is clean already, something may have recalculated it since it was queued
+            recomputed += UpdateSubtree(entity);
+        }
+
+        return recomputed;
+    }
+
+    uint32_t Scene::UpdateSubtree(entt::entity root)
+    {
+        uint32_t recomputed = 0;
+        m_pending.clear();
+        m_pending.push_back(root);
+
+        while (!m_pending.empty())
+        {
+            auto entity = m_pending.back();
+            m_pending.pop_back();
+
+            auto &relation = m_registry.get<RelationshipComponent>(entity);
+            auto transform = m_registry.try_get<TransformComponent>(entity);
+
+            if (!transform)
+                continue;
+
+            transform->SetParent(relation.Parent != entt::null ? m_registry.try_get<TransformComponent>(relation.Parent) : nullptr);
+            bool changed = transform->CalculateTranformationMatrix();
+            recomputed += changed;
+
+            //? children of a node that did not change are not affected, the root is always descended,
+            //? its children compare the version of their parent on their own
+            if (!changed && entity != root)
+                continue;
+
+            for (auto child = relation.FirstChild; child != entt::null; child = m_registry.get<RelationshipComponent>(child).NextSibling)
+                m_pending.push_back(child);
+        }
+
+        return recomputed;
+    }
+}
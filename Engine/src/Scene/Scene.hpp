@@ -32,6 +32,12 @@ namespace ant
             return m_sceneRef->m_registry.template get<T>(m_entityId);
         }
 
+        //? parent TransformComponent is applied on top of this one by Scene::UpdateTransforms
+        void SetParent(Entity parent);
+        void RemoveParent();
+
+        inline entt::entity GetId() const { return m_entityId; }
+
     private:
         entt::entity m_entityId;
         Scene *m_sceneRef;
@@ -42,8 +48,11 @@ namespace ant
         friend class Entity;
 
     public:
-        Scene() {}
-        ~Scene() {}
+        Scene();
+        ~Scene();
+
+        Scene(const Scene &) = delete; // the transforms of the hierarchy point back into the scene
+        Scene &operator=(const Scene &) = delete;
 
         Entity RegisterEntity();
         inline std::string &Label() { return m_label; }
@@ -51,8 +60,44 @@ namespace ant
 
         inline entt::registry &GetRegistry() { return m_registry; }
 
+        //? propagates transforms from parents to children, call before drawing entities with a parent
+        //? after a hierarchy change storage is sorted by depth and one pass in storage order visits parents first,
+        //? otherwise only the subtrees below nodes moved since the last call are walked
+        //? returns the number of matrices recomputed
+        uint32_t UpdateTransforms();
+
+        //? updates transforms and draws every sprite through entt groups, sprites with a TextureComponent are drawn textured
+        //? without sorted submission each group is drawn whole, the one further back first
+        //! call between Renderer2D::BeginScene and Renderer2D::EndScene
+        //! asserts when textured and untextured sprites interleave in depth and sorted submission is off
+        void OnRender();
+
+    private:
+        void SetParent(entt::entity child, entt::entity parent);
+        void UpdateDepth(entt::entity entity, uint32_t depth);
+        void HookTransform(entt::entity entity);
+
+        uint32_t UpdateAllTransforms();
+        uint32_t UpdateDirtyTransforms();
+        uint32_t UpdateSubtree(entt::entity root);
+
+        struct DepthBounds
+        {
+            float min;
+            float max;
+        };
+        template <class Group>
+        static DepthBounds DepthRange(Group &group);
+
+        //? children of a destroyed node move up to its parent
+        void OnRelationshipDestroyed(entt::registry &registry, entt::entity entity);
+        void OnTransformConstructed(entt::registry &registry, entt::entity entity);
+
     private:
         entt::registry m_registry; //! TEMP
+        bool m_hierarchyChanged = false;
+        std::vector<uint32_t> m_dirtyTransforms; // hierarchy nodes moved since the last UpdateTransforms, filled by the thread running OnRender only
+        std::vector<entt::entity> m_pending;
         std::string m_label = "Scene";
     };
 
@@ -0,0 +1,28 @@
+#include "Pch.h"
+#include "debug/Metrics.hpp"
+#include <cstdlib>
+#include <new>
+
+#if ANT_ALLOCATION_METRICS
+//? the array and nothrow forms forward to these, aligned allocations keep the default pair and are not counted
+void *operator new(std::size_t size)
+{
+    ant::Metrics::CountAllocation(size);
+
+    if (void *memory = std::malloc(size ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
+
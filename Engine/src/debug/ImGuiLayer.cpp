@@ -13,6 +13,9 @@
 
 #include "Input/KeyCodes.hpp"
 #include "Core/Application.hpp"
+#include "Render/RenderThread.hpp"
+#include "debug/Instrumentation.hpp"
+#include "debug/Metrics.hpp"
 
 namespace ant
 {
@@ -58,6 +61,7 @@ namespace ant
         auto window = Application::GetInstance()->GetWindow().GetNativeWindow();
         ImGui_ImplGlfw_InitForOpenGL(window, true);
         ImGui_ImplOpenGL3_Init("#version 450");
+        ImGui_ImplOpenGL3_CreateDeviceObjects(); //? now, so OnUpdate never touches gl when it runs off the render thread
     }
 
     void ImGuiLayer::OnUpdate()
@@ -68,6 +72,86 @@ namespace ant
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
+        DrawProfilerPanel();
+        DrawPerformancePanel();
+    }
+
+    void ImGuiLayer::DrawPerformancePanel()
+    {
+        auto &frameTimes = Metrics::GetFrameTimes();
+        const ImVec2 plotSize(0.f, 60.f);
+
+        ImGui::Begin("Performance");
+        ImGui::Text("Frame time, last %u s", MetricHistogram::s_segments);
+        ImGui::Text("p50 %.2f ms   p95 %.2f ms   p99 %.2f ms", frameTimes.GetPercentile(50.0), frameTimes.GetPercentile(95.0), frameTimes.GetPercentile(99.0));
+        ImGui::PlotLines("##frame times", Metrics::GetFrameTimeHistory(), MetricCounter::s_historySize, Metrics::GetFrameTimeOffset(), nullptr, 0.f, FLT_MAX, plotSize);
+        ImGui::Separator();
+
+        //? per frame, average and max over the counter history, hovering a row plots it
+        ImGui::Columns(4, "counters");
+        ImGui::Text("counter");
+        ImGui::NextColumn();
+        ImGui::Text("last");
+        ImGui::NextColumn();
+        ImGui::Text("average");
+        ImGui::NextColumn();
+        ImGui::Text("max");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        Metrics::ForEachCounter([&](const MetricCounter &counter)
+                                {
+                                    ImGui::Text("%s", counter.GetName().c_str());
+                                    if (ImGui::IsItemHovered())
+                                    {
+                                        ImGui::BeginTooltip();
+                                        ImGui::PlotLines("##history", counter.GetHistory(), MetricCounter::s_historySize, counter.GetHistoryOffset(), nullptr, 0.f, FLT_MAX, ImVec2(300.f, 80.f));
+                                        ImGui::EndTooltip();
+                                    }
+                                    ImGui::NextColumn();
+                                    ImGui::Text("%.0f", counter.GetLast());
+                                    ImGui::NextColumn();
+                                    ImGui::Text("%.1f", counter.GetAverage());
+                                    ImGui::NextColumn();
+                                    ImGui::Text("%.0f", counter.GetMax());
+                                    ImGui::NextColumn(); });
+
+        ImGui::Columns(1);
+        ImGui::Separator();
+
+        Metrics::ForEachGauge([](const MetricGauge &gauge)
+                              { ImGui::Text("%s: %.2f", gauge.GetName().c_str(), gauge.Get()); });
+
+        ImGui::End();
+    }
+
+    void ImGuiLayer::DrawProfilerPanel()
+    {
+        static constexpr ProfileCategory categories[] = {ProfileCategory::General, ProfileCategory::Render, ProfileCategory::Scene,
+                                                         ProfileCategory::Assets, ProfileCategory::Events};
+        auto instrumentor = Instrumentor::Get();
+        uint32_t mask = instrumentor->GetCategoryMask();
+
+        ImGui::Begin("Profiler");
+        ImGui::Text("Session: %s, level %d", instrumentor->IsCapturing() ? "capturing" : instrumentor->IsActive() ? "running" : "stopped", ANT_PROFILE_LEVEL);
+
+        for (auto category : categories)
+        {
+            bool enabled = mask & uint32_t(category);
+            if (ImGui::Checkbox(GetProfileCategoryName(category), &enabled))
+                instrumentor->SetCategoryMask(enabled ? mask | uint32_t(category) : mask & ~uint32_t(category));
+        }
+
+        if (instrumentor->IsCapturing())
+        {
+            if (ImGui::Button("Dump capture"))
+                instrumentor->RequestDump();
+
+            ImGui::SameLine();
+            ImGui::Text("%u written", instrumentor->GetStats().dumps);
+        }
+
+        ImGui::End();
     }
 
     void ImGuiLayer::OnDraw()
@@ -87,6 +171,45 @@ namespace ant
         }
     }
 
+    namespace
+    {
+        //? ImDrawData only points at the draw lists of the context, the next NewFrame rewrites them
+        struct ImGuiDrawSnapshot
+        {
+            ImDrawData data;
+            std::vector<ImDrawList *> lists;
+
+            ~ImGuiDrawSnapshot()
+            {
+                for (auto list : lists)
+                    IM_DELETE(list);
+            }
+        };
+    }
+
+    bool ImGuiLayer::OnSnapshot(RenderPacket &packet)
+    {
+        CORE_PROFILE_FUNC();
+        ImGuiIO &io = ImGui::GetIO();
+        CORE_ASSERT(!(io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable), "ImGui viewports create gl contexts, they need synchronous drawing!");
+
+        ImGui::EndFrame();
+        ImGui::Render();
+
+        auto drawData = ImGui::GetDrawData();
+        auto snapshot = MakeRef<ImGuiDrawSnapshot>();
+        snapshot->data = *drawData;
+        snapshot->lists.resize(drawData->CmdListsCount);
+
+        for (int i = 0; i < drawData->CmdListsCount; i++)
+            snapshot->lists[i] = drawData->CmdLists[i]->CloneOutput();
+
+        snapshot->data.CmdLists = snapshot->lists.data();
+        packet.Submit([snapshot]
+                      { ImGui_ImplOpenGL3_RenderDrawData(&snapshot->data); });
+        return true;
+    }
+
     void ImGuiLayer::OnDetach()
     {
         ImGui_ImplOpenGL3_Shutdown();
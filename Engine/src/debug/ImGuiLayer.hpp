@@ -17,6 +17,7 @@ namespace ant
         virtual void OnDraw() override;
         virtual void OnDetach() override;
         virtual void OnEvent(Event *event) override;
+        virtual bool OnSnapshot(RenderPacket &packet) override; // copies the draw lists, the render thread draws the copy
 
         void OnMouseMoved(Event *e);
         void OnMouseScrolled(Event *e);
@@ -29,6 +30,10 @@ namespace ant
         inline static void SetEventBlocking(bool block = true) { s_blockEvents = block; }
         inline static bool IsBlockingEvents() { return s_blockEvents; }
 
+    private:
+        void DrawProfilerPanel(); // toggles the Instrumentor categories
+        void DrawPerformancePanel(); // frame time percentiles and the Metrics counters
+
     private:
         static bool s_blockEvents;
     };
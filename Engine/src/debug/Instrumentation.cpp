@@ -2,87 +2,444 @@
 #include "debug/Instrumentation.hpp"
 #include <thread>
 #include <algorithm>
+#include <charconv>
+#include <utility>
 #include "Core/Core.hpp"
 
 namespace ant
 {
-    void Instrumentor::BeginSession(const std::string &name)
+    thread_local Instrumentor::ThreadBuffer *Instrumentor::s_threadBuffer = nullptr;
+    thread_local Instrumentor::ThreadLease Instrumentor::s_threadLease;
+
+    namespace
     {
-        m_OutputStream.open(name + "_profiles.json");
+        constexpr auto s_writerPeriod = std::chrono::milliseconds(5); // a ring holds ~16k scopes, plenty for 5 ms
+        constexpr size_t s_maxCaptured = 1 << 20;                        // 32 MB, bounds a capture when nobody marks frames
+        constexpr const char *s_frameName = "Frame";
+
+        //? binary format, little endian:
+        //? "ANTPROF2", then records starting with their type byte
+        //? name:  u64 id, u16 length, length bytes
+        //? scope: u64 name id, u32 thread, u32 category bit, u64 start ticks, u64 end ticks
+        //? clock: u64 origin ticks, f64 ticks per microsecond, written last
+        enum : uint8_t
+        {
+            binaryName = 1,
+            binaryScope = 2,
+            binaryClock = 3
+        };
+
+        template <class T>
+        void Append(std::string &out, const T &value)
+        {
+            out.append((const char *)&value, sizeof(T));
+        }
+
+        //? microseconds with 3 decimals, integer formatting keeps the writer well ahead of the producers
+        void AppendMicroseconds(std::string &out, int64_t nanoseconds)
+        {
+            char buffer[32];
+            char *end = buffer;
+
+            if (nanoseconds < 0)
+            {
+                *end++ = '-';
+                nanoseconds = -nanoseconds;
+            }
+
+            end = std::to_chars(end, buffer + sizeof(buffer), nanoseconds / 1000).ptr;
+            int64_t fraction = nanoseconds % 1000;
+            *end++ = '.';
+            *end++ = char('0' + fraction / 100);
+            *end++ = char('0' + fraction / 10 % 10);
+            *end++ = char('0' + fraction % 10);
+            out.append(buffer, end);
+        }
+    } // namespace
+
+    const char *GetProfileCategoryName(ProfileCategory category)
+    {
+        switch (category)
+        {
+        case ProfileCategory::General:
+            return "general";
+        case ProfileCategory::Render:
+            return "render";
+        case ProfileCategory::Scene:
+            return "scene";
+        case ProfileCategory::Assets:
+            return "assets";
+        case ProfileCategory::Events:
+            return "events";
+        case ProfileCategory::Frame:
+            return "frame";
+        default:
+            return "unknown";
+        }
+    }
+
+    Instrumentor::ThreadLease::~ThreadLease()
+    {
+        if (s_threadBuffer)
+            s_threadBuffer->owned.store(false, std::memory_order_release);
+    }
+
+    Instrumentor::~Instrumentor()
+    {
+        if (IsActive())
+            EndSession();
+    }
+
+    void Instrumentor::BeginSession(const std::string &name, ProfileFormat format)
+    {
+        CORE_ASSERT(!IsActive(), "Profiling session already running!");
+        std::lock_guard lock(m_Mutex);
+
+        m_capture = false;
+        m_format = format;
+        m_dumpRequested.store(false, std::memory_order_relaxed);
+        m_OutputStream.open(name + (format == ProfileFormat::ChromeJson ? "_profiles.json" : "_profiles.bin"), std::ios::binary);
         WriteHeader();
+        StartSession(name);
+    }
+
+    void Instrumentor::BeginCapture(const std::string &name, uint32_t frames, float thresholdMilliseconds)
+    {
+        CORE_ASSERT(!IsActive(), "Profiling session already running!");
+        std::lock_guard lock(m_Mutex);
+
+        m_capture = true;
+        m_format = ProfileFormat::ChromeJson;
+        m_captureFrames = std::max(frames, 1u);
+        m_captureThreshold = thresholdMilliseconds * 1000.0;
+        m_framesSinceDump = m_captureFrames; // the first slow frame dumps right away
+        m_dumpPending = false;
+        m_dumpRequested.store(false, std::memory_order_relaxed);
+        m_frames.clear();
+        m_captured.clear();
+        StartSession(name);
+    }
+
+    void Instrumentor::StartSession(const std::string &name)
+    {
+        //? leftovers of the last session were recorded after it ended, nobody is draining right now
+        for (auto &buffer : m_buffers)
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+
+        m_sessionName = name;
+        m_names.clear();
+        m_originTicks = Now();
+        m_originTime = std::chrono::steady_clock::now();
+
+        m_stopWriter = false;
+        m_writer = std::thread(&Instrumentor::WriterLoop, this);
+        m_active.store(true, std::memory_order_release);
+        s_enabledMask.store(m_categoryMask.load(std::memory_order_relaxed), std::memory_order_release);
     }
 
     void Instrumentor::EndSession()
     {
-        m_ProfileCount = 0;
+        {
+            std::lock_guard lock(m_Mutex);
+            s_enabledMask.store(0, std::memory_order_release);
+            m_active.store(false, std::memory_order_release);
+            m_stopWriter = true;
+        }
+
+        m_wake.notify_one();
+        m_writer.join();
+
+        if (m_capture)
+        {
+            m_frames.clear();
+            m_captured.clear();
+            return;
+        }
+
+        //? the writer is gone, this thread finishes the file
+        UpdateClock();
+        Drain();
         WriteFooter();
+        Flush();
         m_OutputStream.close();
+        m_ProfileCount = 0;
     }
 
-    void Instrumentor::SaveProfile(const ProfileData &data)
+    void Instrumentor::MarkFrame()
     {
-        if (m_ProfileCount++ > 0)
-            m_OutputStream << ",";
+        uint64_t now = Now();
 
-        std::string name = data.Name;
-        std::replace(name.begin(), name.end(), '"', '\'');
+        if (IsActive() && m_lastFrame)
+            SaveProfile({s_frameName, m_lastFrame, now, 0, ProfileCategory::Frame});
 
-        m_OutputStream << "{";
-        m_OutputStream << "\"cat\":\"function\",";
-        m_OutputStream << "\"dur\":" << (data.End - data.Start) << ',';
-        m_OutputStream << "\"name\":\"" << name << "\",";
-        m_OutputStream << "\"ph\":\"X\",";
-        m_OutputStream << "\"pid\":0,";
-        m_OutputStream << "\"tid\":" << data.ThreadID << ",";
-        m_OutputStream << "\"ts\":" << data.Start;
-        m_OutputStream << "}";
+        m_lastFrame = now;
+    }
 
-        m_OutputStream.flush();
+    void Instrumentor::RequestDump()
+    {
+        //? a plain session streams everything already, nothing would clear the request and the writer would spin
+        if (!IsCapturing())
+            return;
+
+        m_dumpRequested.store(true, std::memory_order_relaxed);
+        m_wake.notify_one();
     }
 
-    void Instrumentor::WriteHeader()
+    void Instrumentor::SetCategoryMask(uint32_t mask)
     {
-        m_OutputStream << "{\"otherData\": {},\"traceEvents\":[";        
-        m_OutputStream.flush();
-        m_ProfileCount = 0;
+        std::lock_guard lock(m_Mutex); // BeginSession/EndSession publish the mask under it too
+        m_categoryMask.store(mask, std::memory_order_relaxed);
+
+        if (IsActive())
+            s_enabledMask.store(mask, std::memory_order_release);
     }
 
-    void Instrumentor::WriteFooter()
+    Instrumentor::ThreadBuffer &Instrumentor::RegisterThread()
     {
-        m_OutputStream << "]}";
-        m_OutputStream.flush();
+        (void)&s_threadLease; // constructed on first use, releases the buffer when the thread exits
+        std::lock_guard lock(m_Mutex);
+
+        for (auto &buffer : m_buffers)
+        {
+            bool owned = false;
+            if (buffer->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+            {
+                s_threadBuffer = buffer.get();
+                break;
+            }
+        }
+
+        if (!s_threadBuffer)
+        {
+            s_threadBuffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+            s_threadBuffer->owned.store(true, std::memory_order_relaxed);
+        }
+
+        s_threadBuffer->threadId = m_nextThreadId++;
+        return *s_threadBuffer;
+    }
+
+    Instrumentor::Stats Instrumentor::GetStats()
+    {
+        std::lock_guard lock(m_Mutex);
+        Stats stats;
+
+        for (auto &buffer : m_buffers)
+        {
+            stats.recorded += buffer->head.load(std::memory_order_relaxed);
+            stats.dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+
+        stats.dumps = m_dumps.load(std::memory_order_relaxed);
+
+        return stats;
     }
 
-    InstrumentationTimer::InstrumentationTimer(const std::string &name)
+    void Instrumentor::WriterLoop()
     {
-        m_profileData.Name = name;
-        Start();
+        std::unique_lock lock(m_Mutex);
+
+        while (!m_stopWriter)
+        {
+            m_wake.wait_for(lock, s_writerPeriod, [this]
+                            { return m_stopWriter || m_dumpRequested.load(std::memory_order_relaxed); });
+
+            lock.unlock();
+            UpdateClock();
+
+            if (m_capture)
+            {
+                //? a slow frame seen in the last pass, the drain below brings in what the other threads finished meanwhile
+                bool dump = std::exchange(m_dumpPending, false);
+                Drain();
+                TrimCapture();
+
+                if (dump | m_dumpRequested.exchange(false, std::memory_order_relaxed))
+                    WriteCapture();
+            }
+            else
+            {
+                m_dumpRequested.store(false, std::memory_order_relaxed);
+                Drain();
+                Flush();
+            }
+
+            lock.lock();
+        }
     }
 
-    InstrumentationTimer::~InstrumentationTimer()
+    void Instrumentor::UpdateClock()
     {
-        if (!m_stopped)
-            Stop();
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        //? the tsc rate is measured against steady_clock over the whole session, more precise the longer it runs
+        uint64_t ticks = Now();
+        double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_originTime).count();
+
+        if (microseconds > 1000.0)
+            m_ticksPerMicrosecond = double(ticks - m_originTicks) / microseconds;
+#endif
     }
 
-    void InstrumentationTimer::Start()
+    void Instrumentor::Drain()
     {
-        m_time = std::chrono::high_resolution_clock::now();
+        //? buffers are never removed, only the registration needs the lock
+        std::vector<ThreadBuffer *> buffers;
+        {
+            std::lock_guard lock(m_Mutex);
+            for (auto &buffer : m_buffers)
+                buffers.push_back(buffer.get());
+        }
+
+        for (auto buffer : buffers)
+        {
+            uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            uint64_t head = buffer->head.load(std::memory_order_acquire);
+
+            for (; tail != head; tail++)
+            {
+                const ProfileData &data = buffer->events[tail & (ThreadBuffer::capacity - 1)];
+                m_capture ? Capture(data) : WriteEvent(data);
+            }
+
+            buffer->tail.store(tail, std::memory_order_release);
+        }
     }
 
-    void InstrumentationTimer::Stop()
+    void Instrumentor::Capture(const ProfileData &data)
     {
-        m_stopped = true;
-        auto endPoint = std::chrono::high_resolution_clock::now();
+        if (data.Name != s_frameName)
+        {
+            m_captured.push_back(data);
+            return;
+        }
 
-        auto start = std::chrono::time_point_cast<std::chrono::microseconds>(m_time).time_since_epoch().count();
-        auto end = std::chrono::time_point_cast<std::chrono::microseconds>(endPoint).time_since_epoch().count();
+        m_frames.push_back(data);
+        m_framesSinceDump++;
 
-        m_profileData.Start = start;
-        m_profileData.End = end;
-        m_profileData.ThreadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        //? one dump per window, a stretch of slow frames would otherwise write the same frames again and again
+        double microseconds = double(data.End - data.Start) / m_ticksPerMicrosecond;
+        if (m_captureThreshold > 0.0 && microseconds > m_captureThreshold && m_framesSinceDump >= m_captureFrames)
+        {
+            m_dumpPending = true;
+            m_framesSinceDump = 0;
+        }
+    }
 
-        Instrumentor::Get()->SaveProfile(m_profileData);
+    void Instrumentor::TrimCapture()
+    {
+        while (m_frames.size() > m_captureFrames)
+            m_frames.pop_front();
+
+        //? the threads are drained one after another, the front is only roughly the oldest, WriteCapture filters the rest
+        uint64_t windowStart = m_frames.empty() ? 0 : m_frames.front().Start;
+        while (!m_captured.empty() && (m_captured.front().End < windowStart || m_captured.size() > s_maxCaptured))
+            m_captured.pop_front();
+    }
+
+    void Instrumentor::WriteCapture()
+    {
+        std::string path = m_sessionName + "_capture_" + std::to_string(m_dumps.load(std::memory_order_relaxed)) + ".json";
+        m_OutputStream.open(path, std::ios::binary);
+        WriteHeader();
+
+        uint64_t windowStart = m_frames.empty() ? 0 : m_frames.front().Start;
+
+        for (auto &frame : m_frames)
+            WriteEvent(frame);
+
+        for (auto &data : m_captured)
+        {
+            if (data.End >= windowStart)
+                WriteEvent(data);
+        }
+
+        WriteFooter();
+        Flush();
+        m_OutputStream.close();
+        m_dumps.fetch_add(1, std::memory_order_relaxed);
+        CORE_INFO("Profile capture of {0} frames written to {1}", m_frames.size(), path);
+    }
+
+    void Instrumentor::WriteEvent(const ProfileData &data)
+    {
+        auto [name, added] = m_names.try_emplace(data.Name);
+
+        if (m_format == ProfileFormat::Binary)
+        {
+            if (added)
+            {
+                std::string_view view = data.Name;
+                uint16_t length = std::min<size_t>(view.size(), UINT16_MAX);
+                Append(m_pending, binaryName);
+                Append(m_pending, uint64_t(data.Name));
+                Append(m_pending, length);
+                m_pending.append(view.data(), length);
+            }
+
+            Append(m_pending, binaryScope);
+            Append(m_pending, uint64_t(data.Name));
+            Append(m_pending, data.ThreadID);
+            Append(m_pending, uint32_t(data.Category));
+            Append(m_pending, data.Start);
+            Append(m_pending, data.End);
+            return;
+        }
+
+        if (added)
+        {
+            //? everything up to the thread id is the same for every scope of this name, a name belongs to one macro and its category
+            name->second = data.Name;
+            std::replace(name->second.begin(), name->second.end(), '"', '\'');
+            name->second = std::string("{\"cat\":\"") + GetProfileCategoryName(data.Category) + "\",\"name\":\"" + name->second + "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+        }
+
+        double nanosecondsPerTick = 1000.0 / m_ticksPerMicrosecond;
+        char thread[16];
+
+        if (m_ProfileCount++)
+            m_pending += ',';
+
+        m_pending += name->second;
+        m_pending.append(thread, std::to_chars(thread, thread + sizeof(thread), data.ThreadID).ptr);
+        m_pending += ",\"ts\":";
+        AppendMicroseconds(m_pending, int64_t(double(int64_t(data.Start - m_originTicks)) * nanosecondsPerTick));
+        m_pending += ",\"dur\":";
+        AppendMicroseconds(m_pending, int64_t(double(data.End - data.Start) * nanosecondsPerTick));
+        m_pending += '}';
+    }
+
+    void Instrumentor::WriteHeader()
+    {
+        m_ProfileCount = 0;
+
+        if (m_format == ProfileFormat::Binary)
+            m_pending += "ANTPROF2";
+        else
+            m_pending += "{\"otherData\": {},\"traceEvents\":[";
+
+        Flush();
+    }
+
+    void Instrumentor::WriteFooter()
+    {
+        if (m_format == ProfileFormat::Binary)
+        {
+            Append(m_pending, binaryClock);
+            Append(m_pending, m_originTicks);
+            Append(m_pending, m_ticksPerMicrosecond);
+        }
+        else
+            m_pending += "]}";
+    }
+
+    void Instrumentor::Flush()
+    {
+        if (m_pending.empty())
+            return;
+
+        m_OutputStream.write(m_pending.data(), m_pending.size());
+        m_OutputStream.flush();
+        m_pending.clear();
     }
 
-}
\ No newline at end of file
+}
@@ -1,27 +1,124 @@
 #pragma once
+#include <stdint.h>
 #include <string>
 #include <fstream>
 #include <chrono>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <condition_variable>
+#include <unordered_map>
+#include <deque>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//? 0 strips every scope, 1 keeps the coarse ones (functions, named scopes), 2 also keeps the per draw call detail
+#ifndef ANT_PROFILE_LEVEL
+#define ANT_PROFILE_LEVEL 2
+#endif
 
 namespace ant
 {
+    //? bit mask, a scope is recorded when its bit is set in the mask of a running session
+    enum class ProfileCategory : uint32_t
+    {
+        None = 0,
+        General = 1 << 0, // everything without a category of its own
+        Render = 1 << 1,
+        Scene = 1 << 2,
+        Assets = 1 << 3,
+        Events = 1 << 4,
+        All = General | Render | Scene | Assets | Events,
+        Frame = 1 << 5 // Instrumentor::MarkFrame, recorded regardless of the mask
+    };
+
+    const char *GetProfileCategoryName(ProfileCategory category);
 
+    //! Name has to outlive the session, string literals and __PRETTY_FUNCTION__ do
     struct ProfileData
     {
-        std::string Name;
-        int64_t Start, End;
+        const char *Name;
+        uint64_t Start, End; // Instrumentor::Now ticks
         uint32_t ThreadID;
+        ProfileCategory Category;
     };
 
+    enum class ProfileFormat : uint8_t
+    {
+        ChromeJson = 0, // chrome://tracing and Perfetto
+        Binary          // raw ticks and a name table, see Instrumentor::WriteBinary
+    };
+
+    //? scopes go into a lock-free ring of the thread that ran them, a background thread drains the rings into the file
+    //? a full ring drops the scope instead of waiting for the writer
+    //? a capture keeps only the last frames in memory instead, and writes them out when asked or after a slow frame
     class Instrumentor
     {
     public:
-        ~Instrumentor() {}
+        struct Stats
+        {
+            uint64_t recorded = 0;
+            uint64_t dropped = 0; // ring full, the writer fell behind
+            uint32_t dumps = 0;   // capture files written
+        };
+
+        ~Instrumentor();
+
+        void BeginSession(const std::string &name, ProfileFormat format = ProfileFormat::ChromeJson);
+        //? rolling window of the last frames, nothing goes to disk until RequestDump or a frame above thresholdMilliseconds (0 never)
+        //? dumps are chrome json files named name_capture_<n>.json
+        void BeginCapture(const std::string &name, uint32_t frames = 120, float thresholdMilliseconds = 0.f);
+        void EndSession(); // writes what is left and closes the file, a capture is discarded
 
-        void BeginSession(const std::string &name);
-        void EndSession();
+        inline bool IsActive() const { return m_active.load(std::memory_order_relaxed); }
+        inline bool IsCapturing() const { return IsActive() && m_capture; }
 
-        void SaveProfile(const ProfileData &data);
+        //! from one thread only, once per frame, the time between two calls is the frame
+        void MarkFrame();
+        void RequestDump(); // the writer thread writes the current capture window shortly after, no-op outside a capture
+
+        //? takes effect immediately when a session runs, otherwise with the next BeginSession
+        void SetCategoryMask(uint32_t mask);
+        inline uint32_t GetCategoryMask() const { return m_categoryMask.load(std::memory_order_relaxed); }
+
+        //? the only check a scope makes, zero without a session so nothing is recorded between sessions
+        static inline bool IsEnabled(ProfileCategory category) { return s_enabledMask.load(std::memory_order_relaxed) & uint32_t(category); }
+
+        //? never blocks, only touches the ring of the calling thread
+        inline void SaveProfile(const ProfileData &data)
+        {
+            ThreadBuffer *buffer = s_threadBuffer ? s_threadBuffer : &RegisterThread();
+            uint64_t head = buffer->head.load(std::memory_order_relaxed);
+
+            if (head - buffer->tail.load(std::memory_order_acquire) >= ThreadBuffer::capacity)
+            {
+                buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            ProfileData &event = buffer->events[head & (ThreadBuffer::capacity - 1)];
+            event = data;
+            event.ThreadID = buffer->threadId;
+            buffer->head.store(head + 1, std::memory_order_release);
+        }
+
+        Stats GetStats();
+
+        //? tsc on x86, constant rate on every cpu since nehalem, steady_clock nanoseconds elsewhere
+        static inline uint64_t Now()
+        {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
 
         static Instrumentor *Get()
         {
@@ -30,38 +127,131 @@ namespace ant
         }
 
     private:
-        std::ofstream m_OutputStream;
-        size_t m_ProfileCount = 0;
+        //? single producer (the owning thread), single consumer (the writer thread)
+        struct ThreadBuffer
+        {
+            static constexpr uint64_t capacity = 1 << 14;
+
+            std::unique_ptr<ProfileData[]> events = std::make_unique<ProfileData[]>(capacity);
+            alignas(64) std::atomic<uint64_t> head = 0;
+            alignas(64) std::atomic<uint64_t> tail = 0;
+            std::atomic<uint64_t> dropped = 0;
+            std::atomic<bool> owned = false; // released when the thread exits, the next new thread reuses it
+            uint32_t threadId = 0;
+        };
+
+        struct ThreadLease
+        {
+            ~ThreadLease();
+        };
+
+    private:
         Instrumentor() {}
+        ThreadBuffer &RegisterThread();
+
+        void StartSession(const std::string &name);
+        void WriterLoop();
+        void Drain();
+        void Capture(const ProfileData &data);
+        void TrimCapture();
+        void WriteCapture();
+        void WriteEvent(const ProfileData &data);
         void WriteHeader();
         void WriteFooter();
+        void Flush();
+        void UpdateClock();
+
+    private:
+        static thread_local ThreadBuffer *s_threadBuffer;
+        static thread_local ThreadLease s_threadLease;
+        static inline std::atomic<uint32_t> s_enabledMask = 0; // m_categoryMask while a session runs
+
+        std::atomic<bool> m_active = false;
+        std::atomic<uint32_t> m_categoryMask = uint32_t(ProfileCategory::All);
+        std::atomic<bool> m_dumpRequested = false;
+        std::atomic<uint32_t> m_dumps = 0;
+        uint64_t m_lastFrame = 0; // MarkFrame thread only
+        ProfileFormat m_format = ProfileFormat::ChromeJson;
+
+        std::mutex m_Mutex; // guards m_buffers and the writer state below
+        std::condition_variable m_wake;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+        uint32_t m_nextThreadId = 0;
+        std::thread m_writer;
+        bool m_stopWriter = false;
+
+        //? writer thread only, and the session begin/end around it
+        std::ofstream m_OutputStream;
+        std::string m_pending;                                   // serialized, not written yet
+        std::unordered_map<const char *, std::string> m_names;  // escaped for json, or known to the binary name table
+        size_t m_ProfileCount = 0;
+        uint64_t m_originTicks = 0;
+        std::chrono::steady_clock::time_point m_originTime;
+        double m_ticksPerMicrosecond = 1000.0;
+
+        //? capture, writer thread only once the session runs
+        bool m_capture = false;
+        bool m_dumpPending = false; // a slow frame was seen, written after one more drain so other threads catch up
+        std::string m_sessionName;
+        uint32_t m_captureFrames = 0;
+        uint32_t m_framesSinceDump = 0;
+        double m_captureThreshold = 0.0; // microseconds
+        std::deque<ProfileData> m_frames;
+        std::deque<ProfileData> m_captured;
     };
 
     class InstrumentationTimer
     {
     public:
-        InstrumentationTimer(const std::string &name);
-        ~InstrumentationTimer();
+        //? whether the scope records is decided once here, the destructor only tests m_enabled
+        InstrumentationTimer(const char *name, ProfileCategory category = ProfileCategory::General)
+            : m_name(name), m_enabled(Instrumentor::IsEnabled(category)), m_category(category)
+        {
+            if (m_enabled) [[unlikely]]
+                m_start = Instrumentor::Now();
+        }
 
-        void Start();
-        void Stop();
+        ~InstrumentationTimer()
+        {
+            if (m_enabled) [[unlikely]]
+                Instrumentor::Get()->SaveProfile({m_name, m_start, Instrumentor::Now(), 0, m_category});
+        }
+
+        InstrumentationTimer(const InstrumentationTimer &) = delete;
+        InstrumentationTimer &operator=(const InstrumentationTimer &) = delete;
 
     private:
-        std::chrono::time_point<std::chrono::high_resolution_clock> m_time;
-        ProfileData m_profileData;
-        bool m_stopped = false;
+        const char *m_name;
+        bool m_enabled; // scopes opened outside a session or with their category masked are never recorded
+        ProfileCategory m_category;
+        uint64_t m_start;
     };
-#ifdef __linux__ 
-
-#define CORE_PROFILE_SCOPE(name) InstrumentationTimer profile ## _ ## __LINE__(name)
-#define CORE_PROFILE_FUNC() InstrumentationTimer profile ## _ ## __LINE__ (__PRETTY_FUNCTION__)
+}
 
-#endif
+#define ANT_CONCAT_IMPL(a, b) a##b
+#define ANT_CONCAT(a, b) ANT_CONCAT_IMPL(a, b)
 
 #ifdef _WIN32
+#define ANT_FUNC_SIGNATURE __FUNCTION__
+#else
+#define ANT_FUNC_SIGNATURE __PRETTY_FUNCTION__
+#endif
 
-#define CORE_PROFILE_SCOPE(name) InstrumentationTimer profile ## _ ## __LINE__(name)
-#define CORE_PROFILE_FUNC() InstrumentationTimer profile ## _ ## __LINE__ (__FUNCTION__)
+//? category is one of the ProfileCategory names, CORE_PROFILE_SCOPE_CAT("Sort", Scene)
+#if ANT_PROFILE_LEVEL >= 1
+#define CORE_PROFILE_SCOPE_CAT(name, category) ::ant::InstrumentationTimer ANT_CONCAT(profile_, __COUNTER__)(name, ::ant::ProfileCategory::category)
+#define CORE_PROFILE_FUNC_CAT(category) CORE_PROFILE_SCOPE_CAT(ANT_FUNC_SIGNATURE, category)
+#else
+#define CORE_PROFILE_SCOPE_CAT(name, category)
+#define CORE_PROFILE_FUNC_CAT(category)
+#endif
 
+//? scopes run many times per frame, only compiled in at the highest level
+#if ANT_PROFILE_LEVEL >= 2
+#define CORE_PROFILE_DETAIL_CAT(name, category) CORE_PROFILE_SCOPE_CAT(name, category)
+#else
+#define CORE_PROFILE_DETAIL_CAT(name, category)
 #endif
-}
\ No newline at end of file
+
+#define CORE_PROFILE_SCOPE(name) CORE_PROFILE_SCOPE_CAT(name, General)
+#define CORE_PROFILE_FUNC() CORE_PROFILE_FUNC_CAT(General)
@@ -0,0 +1,175 @@
+#include "Pch.h"
+#include "debug/Metrics.hpp"
+#include <chrono>
+
+namespace ant
+{
+    std::mutex Metrics::s_mutex;
+    std::vector<std::unique_ptr<MetricCounter>> Metrics::s_counters;
+    std::vector<std::unique_ptr<MetricGauge>> Metrics::s_gauges;
+    std::vector<std::unique_ptr<MetricHistogram>> Metrics::s_histograms;
+    std::array<float, MetricCounter::s_historySize> Metrics::s_frameTimes{};
+    uint32_t Metrics::s_frame = 0;
+    std::array<Metrics::AllocationSlot, Metrics::s_allocationSlots> Metrics::s_allocationSlotArray{};
+    std::atomic<uint32_t> Metrics::s_claimedSlots = 0;
+    thread_local Metrics::AllocationSlot *Metrics::s_threadSlot = nullptr;
+    uint64_t Metrics::s_lastAllocations = 0;
+    uint64_t Metrics::s_lastAllocatedBytes = 0;
+
+    namespace
+    {
+        constexpr auto s_segmentDuration = std::chrono::seconds(1);
+
+        template <class T, class... Args>
+        T &FindOrAdd(std::vector<std::unique_ptr<T>> &metrics, const std::string &name, Args &&...args)
+        {
+            for (auto &metric : metrics)
+            {
+                if (metric->GetName() == name)
+                    return *metric;
+            }
+
+            return *metrics.emplace_back(std::make_unique<T>(name, std::forward<Args>(args)...));
+        }
+    } // namespace
+
+    void MetricCounter::EndFrame()
+    {
+        float value = float(m_value.exchange(0, std::memory_order_relaxed));
+        float &slot = m_history[m_frame];
+
+        m_sum += double(value) - double(slot);
+        slot = value;
+        m_frame = (m_frame + 1) % s_historySize;
+    }
+
+    double MetricHistogram::GetPercentile(double percentile) const
+    {
+        std::array<uint64_t, s_bucketCount> buckets{};
+        uint64_t count = 0;
+
+        for (auto &segment : m_segments)
+        {
+            for (uint32_t i = 0; i < s_bucketCount; i++)
+            {
+                uint32_t samples = segment[i].load(std::memory_order_relaxed);
+                buckets[i] += samples;
+                count += samples;
+            }
+        }
+
+        if (!count)
+            return 0.0;
+
+        //? rank of the sample at the percentile, 1 based
+        uint64_t rank = std::max<uint64_t>(1, uint64_t(percentile / 100.0 * count + 0.5));
+        uint64_t seen = 0;
+
+        for (uint32_t i = 0; i < s_bucketCount; i++)
+        {
+            seen += buckets[i];
+            if (seen >= rank)
+                return std::min(m_min + (i + 1) / m_scale, m_max);
+        }
+
+        return m_max;
+    }
+
+    uint64_t MetricHistogram::GetCount() const
+    {
+        uint64_t count = 0;
+
+        for (auto &segment : m_segments)
+        {
+            for (auto &bucket : segment)
+                count += bucket.load(std::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    void MetricHistogram::Rotate()
+    {
+        //? a Record racing with the switch may land in the segment being cleared, one sample lost at most
+        uint32_t next = (m_current.load(std::memory_order_relaxed) + 1) % s_segments;
+
+        for (auto &bucket : m_segments[next])
+            bucket.store(0, std::memory_order_relaxed);
+
+        m_current.store(next, std::memory_order_relaxed);
+    }
+
+    MetricCounter &Metrics::GetCounter(const std::string &name)
+    {
+        std::lock_guard lock(s_mutex);
+        return FindOrAdd(s_counters, name);
+    }
+
+    MetricGauge &Metrics::GetGauge(const std::string &name)
+    {
+        std::lock_guard lock(s_mutex);
+        return FindOrAdd(s_gauges, name);
+    }
+
+    MetricHistogram &Metrics::GetHistogram(const std::string &name, double min, double max)
+    {
+        std::lock_guard lock(s_mutex);
+        return FindOrAdd(s_histograms, name, min, max);
+    }
+
+    Metrics::AllocationSlot *Metrics::ClaimAllocationSlot()
+    {
+        uint32_t index = s_claimedSlots.fetch_add(1, std::memory_order_relaxed);
+        return &s_allocationSlotArray[std::min(index, s_allocationSlots - 1)];
+    }
+
+    MetricHistogram &Metrics::GetFrameTimes()
+    {
+        static auto &frameTimes = GetHistogram("frame time", 0.0, 64.0); // 0.25 ms buckets
+        return frameTimes;
+    }
+
+    void Metrics::OnFrame()
+    {
+        using clock = std::chrono::steady_clock;
+        static auto &frameTimes = GetFrameTimes();
+        static auto &allocations = GetCounter("memory.allocations");
+        static auto &allocatedBytes = GetCounter("memory.allocated bytes");
+        static clock::time_point lastFrame = clock::now();
+        static clock::time_point segmentStart = lastFrame;
+
+        auto now = clock::now();
+        float milliseconds = std::chrono::duration<float, std::milli>(now - lastFrame).count();
+        lastFrame = now;
+
+        frameTimes.Record(milliseconds);
+        s_frameTimes[s_frame] = milliseconds;
+        s_frame = (s_frame + 1) % s_frameTimes.size();
+
+        uint64_t allocationSum = 0, byteSum = 0;
+        for (auto &slot : s_allocationSlotArray)
+        {
+            allocationSum += slot.allocations.load(std::memory_order_relaxed);
+            byteSum += slot.bytes.load(std::memory_order_relaxed);
+        }
+
+        allocations.Add(allocationSum - s_lastAllocations);
+        allocatedBytes.Add(byteSum - s_lastAllocatedBytes);
+        s_lastAllocations = allocationSum;
+        s_lastAllocatedBytes = byteSum;
+
+        std::lock_guard lock(s_mutex);
+
+        for (auto &counter : s_counters)
+            counter->EndFrame();
+
+        if (now - segmentStart >= s_segmentDuration)
+        {
+            segmentStart = now;
+
+            for (auto &histogram : s_histograms)
+                histogram->Rotate();
+        }
+    }
+
+} // namespace ant
@@ -0,0 +1,181 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <algorithm>
+
+//? counts every operator new of the program into a counter of the allocating thread, a relaxed store, cheap enough for release builds
+//? define it to 0 to keep the default allocator untouched
+#ifndef ANT_ALLOCATION_METRICS
+#define ANT_ALLOCATION_METRICS 1
+#endif
+
+namespace ant
+{
+    //? summed over a frame, Add is a single relaxed atomic add so any thread can feed it
+    //? Metrics::OnFrame closes the frame and keeps it in the history
+    class MetricCounter
+    {
+    public:
+        static constexpr uint32_t s_historySize = 512; // frames, a few seconds
+
+        MetricCounter(const std::string &name) : m_name(name) {}
+
+        inline void Add(uint64_t value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+
+        //? main thread only, like Metrics::OnFrame
+        inline const std::string &GetName() const { return m_name; }
+        inline float GetLast() const { return m_history[(m_frame + s_historySize - 1) % s_historySize]; }
+        inline float GetAverage() const { return float(m_sum / s_historySize); }
+        inline float GetMax() const { return *std::max_element(m_history.begin(), m_history.end()); }
+        inline const float *GetHistory() const { return m_history.data(); }
+        inline uint32_t GetHistoryOffset() const { return m_frame; } // oldest frame, the history is a ring
+
+    private:
+        friend class Metrics;
+        void EndFrame();
+
+    private:
+        std::string m_name;
+        std::atomic<uint64_t> m_value = 0;
+        std::array<float, s_historySize> m_history{};
+        uint32_t m_frame = 0;
+        double m_sum = 0.0; // of the history, added and removed in the same float values so it never drifts
+    };
+
+    //? last value wins
+    class MetricGauge
+    {
+    public:
+        MetricGauge(const std::string &name) : m_name(name) {}
+
+        inline void Set(double value) { m_value.store(value, std::memory_order_relaxed); }
+        inline double Get() const { return m_value.load(std::memory_order_relaxed); }
+        inline const std::string &GetName() const { return m_name; }
+
+    private:
+        std::string m_name;
+        std::atomic<double> m_value = 0.0;
+    };
+
+    //? fixed buckets over [min, max), values outside land in the first or the last one
+    //? samples of the last s_segments seconds, Metrics::OnFrame clears the oldest second when it starts a new one
+    class MetricHistogram
+    {
+    public:
+        static constexpr uint32_t s_bucketCount = 256;
+        static constexpr uint32_t s_segments = 5;
+
+        MetricHistogram(const std::string &name, double min, double max)
+            : m_name(name), m_min(min), m_max(max), m_scale(s_bucketCount / (max - min)) {}
+
+        inline void Record(double value)
+        {
+            int64_t bucket = std::clamp<int64_t>(int64_t((value - m_min) * m_scale), 0, s_bucketCount - 1);
+            m_segments[m_current.load(std::memory_order_relaxed)][bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //? upper edge of the bucket holding the percentile (0 - 100), max when it is in the last bucket
+        double GetPercentile(double percentile) const;
+        uint64_t GetCount() const;
+        inline const std::string &GetName() const { return m_name; }
+        inline double GetResolution() const { return 1.0 / m_scale; }
+
+    private:
+        friend class Metrics;
+        void Rotate();
+
+    private:
+        std::string m_name;
+        double m_min, m_max, m_scale;
+        std::array<std::array<std::atomic<uint32_t>, s_bucketCount>, s_segments> m_segments{};
+        std::atomic<uint32_t> m_current = 0;
+    };
+
+    //? named metrics fed by the engine systems and read by the ImGuiLayer performance panel
+    //? lookups take a lock, keep the returned reference (function local statics), it stays valid for the whole run
+    class Metrics
+    {
+    public:
+        static MetricCounter &GetCounter(const std::string &name);
+        static MetricGauge &GetGauge(const std::string &name);
+        static MetricHistogram &GetHistogram(const std::string &name, double min, double max);
+
+        //! once per frame from the main thread, records the frame time and closes the frame of every counter
+        static void OnFrame();
+
+        static MetricHistogram &GetFrameTimes(); // milliseconds
+        static inline const float *GetFrameTimeHistory() { return s_frameTimes.data(); }
+        static inline uint32_t GetFrameTimeOffset() { return s_frame; }
+
+        //? from the operator new of debug/Allocations.cpp, OnFrame publishes the sum of every slot as counters
+        //? a thread only writes its own slot, plain relaxed stores so allocations of different threads share no cache line
+        static inline void CountAllocation(size_t size)
+        {
+            AllocationSlot *slot = s_threadSlot;
+            if (!slot) [[unlikely]]
+                slot = s_threadSlot = ClaimAllocationSlot();
+
+            if (slot == &s_allocationSlotArray.back())
+            {
+                slot->allocations.fetch_add(1, std::memory_order_relaxed);
+                slot->bytes.fetch_add(size, std::memory_order_relaxed);
+                return;
+            }
+
+            slot->allocations.store(slot->allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            slot->bytes.store(slot->bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+        }
+
+        template <class Fn>
+        static void ForEachCounter(Fn &&fn)
+        {
+            std::lock_guard lock(s_mutex);
+            for (auto &counter : s_counters)
+                fn(*counter);
+        }
+
+        template <class Fn>
+        static void ForEachGauge(Fn &&fn)
+        {
+            std::lock_guard lock(s_mutex);
+            for (auto &gauge : s_gauges)
+                fn(*gauge);
+        }
+
+    private:
+        //? running totals, never reset, OnFrame keeps the sum it saw last and adds the difference
+        struct alignas(64) AllocationSlot
+        {
+            std::atomic<uint64_t> allocations = 0;
+            std::atomic<uint64_t> bytes = 0;
+        };
+
+        static constexpr uint32_t s_allocationSlots = 64;
+
+        Metrics() {}
+        ~Metrics() {}
+
+        //? slots of finished threads are not reused, past s_allocationSlots threads share the last one with atomic adds
+        static AllocationSlot *ClaimAllocationSlot();
+
+    private:
+        static std::mutex s_mutex;
+        static std::vector<std::unique_ptr<MetricCounter>> s_counters;
+        static std::vector<std::unique_ptr<MetricGauge>> s_gauges;
+        static std::vector<std::unique_ptr<MetricHistogram>> s_histograms;
+
+        static std::array<float, MetricCounter::s_historySize> s_frameTimes;
+        static uint32_t s_frame;
+        //? constant initialized, operator new runs long before main
+        static std::array<AllocationSlot, s_allocationSlots> s_allocationSlotArray;
+        static std::atomic<uint32_t> s_claimedSlots;
+        static thread_local AllocationSlot *s_threadSlot;
+        static uint64_t s_lastAllocations, s_lastAllocatedBytes;
+    };
+
+} // namespace ant
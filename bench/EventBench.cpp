@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <vector>
+#include "Input/EventQueue.hpp"
+
+namespace ant::bench
+{
+    namespace
+    {
+        //? eight events the way a frame of input looks, runs of moves around a click, a key and a scroll
+        Event MakeEvent(uint32_t i)
+        {
+            switch (i % 8)
+            {
+            case 3:
+                return MouseButtonPressedEvent(MouseButtonCode::BUTTON_LEFT, KeyModifier::NONE);
+            case 5:
+                return MouseButtonReleasedEvent(MouseButtonCode::BUTTON_LEFT, KeyModifier::NONE);
+            case 6:
+                return KeyPressedEvent(KeyCode::KEY_A, KeyModifier::SHIFT);
+            case 7:
+                return MouseScrolledEvent({0.0, 1.0});
+            default:
+                return MouseMovedEvent({double(i), double(i / 2)});
+            }
+        }
+
+        //? what every layer does with an event, three typed handlers
+        struct Handled
+        {
+            double x = 0.0;
+            uint32_t clicks = 0, keys = 0;
+
+            void operator()(Event &event)
+            {
+                EventDispatcher dispatcher(event);
+                dispatcher.DispatchEvent<MouseMovedEvent>([this](MouseMovedEvent &e)
+                                                          { x += e.GetMousePos().x; });
+                dispatcher.DispatchEvent<MouseButtonPressedEvent>([this](MouseButtonPressedEvent &)
+                                                                  { clicks++; });
+                dispatcher.DispatchEvent<KeyPressedEvent>([this](KeyPressedEvent &)
+                                                          { keys++; });
+            }
+        };
+
+        //? the events before they became plain data, a virtual base, a std::function callback per event
+        //? and a std::function per dispatched handler
+        struct LegacyEvent
+        {
+            virtual ~LegacyEvent() {}
+            virtual EventType GetEventType() const = 0;
+            bool handled = false;
+        };
+
+        template <class T>
+        struct LegacyEventOf : LegacyEvent
+        {
+            T data;
+            LegacyEventOf(const T &data) : data(data) {}
+            EventType GetEventType() const override { return T::GetStaticType(); }
+        };
+
+        template <class T>
+        bool LegacyDispatch(LegacyEvent &event, const std::function<bool(T &)> &handler)
+        {
+            if (event.GetEventType() != T::GetStaticType())
+                return false;
+            event.handled = handler(static_cast<LegacyEventOf<T> &>(event).data);
+            return true;
+        }
+    }
+
+    static void BM_EventLegacyCallback(benchmark::State &state)
+    {
+        Handled handled;
+        std::function<void(LegacyEvent &)> callback = [&](LegacyEvent &event)
+        {
+            LegacyDispatch<MouseMovedEvent>(event, [&](MouseMovedEvent &e)
+                                            { handled.x += e.GetMousePos().x; return false; });
+            LegacyDispatch<MouseButtonPressedEvent>(event, [&](MouseButtonPressedEvent &)
+                                                    { handled.clicks++; return false; });
+            LegacyDispatch<KeyPressedEvent>(event, [&](KeyPressedEvent &)
+                                            { handled.keys++; return false; });
+        };
+
+        uint32_t i = 0;
+        for (auto _ : state)
+        {
+            //? the glfw callbacks built the event on the stack and called straight into the application
+            Event source = MakeEvent(i++);
+            source.Visit([&](auto &data)
+                         {
+                             using Data = std::decay_t<decltype(data)>;
+                             if constexpr (!std::is_same_v<Data, std::monostate>)
+                             {
+                                 LegacyEventOf<Data> event(data);
+                                 callback(event);
+                             } });
+        }
+
+        benchmark::DoNotOptimize(handled);
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_EventLegacyCallback);
+
+    //? the same events pushed into the queue and drained a frame at a time, range(0) events per frame
+    static void BM_EventQueuePerEvent(benchmark::State &state)
+    {
+        uint32_t frame = uint32_t(state.range(0));
+        EventQueue queue(frame);
+        Handled handled;
+        uint32_t i = 0;
+
+        for (auto _ : state)
+        {
+            for (uint32_t k = 0; k < frame; k++)
+                queue.Push(MakeEvent(i++));
+            queue.Drain(handled);
+        }
+
+        benchmark::DoNotOptimize(handled);
+        auto stats = queue.GetStats();
+        state.counters["coalescedPercent"] = 100.0 * stats.coalesced / stats.pushed;
+        state.SetItemsProcessed(state.iterations() * frame);
+    }
+    BENCHMARK(BM_EventQueuePerEvent)->ArgName("perFrame")->Arg(8)->Arg(64)->Arg(1024);
+
+    //? a million events in one queue and one drain
+    static void BM_EventDispatch1M(benchmark::State &state)
+    {
+        constexpr uint32_t count = 1 << 20;
+        EventQueue queue(count);
+        std::vector<Event> events(count);
+        for (uint32_t i = 0; i < count; i++)
+            events[i] = MakeEvent(i);
+
+        Handled handled;
+        for (auto _ : state)
+        {
+            for (auto &event : events)
+                queue.Push(event);
+            queue.Drain(handled);
+        }
+
+        benchmark::DoNotOptimize(handled);
+        auto stats = queue.GetStats();
+        state.counters["dispatched"] = benchmark::Counter(stats.dispatched, benchmark::Counter::kAvgIterations);
+        state.counters["dropped"] = stats.dropped;
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+    BENCHMARK(BM_EventDispatch1M)->Unit(benchmark::kMillisecond);
+
+} // namespace ant::bench
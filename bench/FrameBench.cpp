@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cmath>
+#include "Headless.hpp"
+#include "Core/Application.hpp"
+#include "Core/Layer.hpp"
+#include "Render/RenderThread.hpp"
+
+namespace ant::bench
+{
+    namespace
+    {
+        //? moves a field of quads every update and draws all of them, the snapshot copies the transforms per packet
+        class FrameLayer : public Layer
+        {
+        public:
+            FrameLayer(uint32_t quads, uint32_t latency)
+                : m_field(quads), m_snapshots(latency + 1, m_field.transforms), m_camera(MakeCamera()) {}
+
+            virtual void OnAttach() override {}
+            virtual void OnDetach() override {}
+            virtual void OnEvent(Event *event) override {}
+
+            virtual void OnUpdate() override
+            {
+                m_time += 1.f / 60.f;
+                for (size_t i = 0; i < m_field.transforms.size(); i++)
+                {
+                    auto &transform = m_field.transforms[i];
+                    auto position = transform.GetPosition();
+                    position.y += 0.01f * std::sin(m_time + float(i));
+                    transform.SetPosition(position);
+                    transform.SetRotation(m_time);
+                }
+            }
+
+            virtual void OnDraw() override { Draw(m_field.transforms); }
+
+            virtual bool OnSnapshot(RenderPacket &packet) override
+            {
+                //? BeginPacket keeps the update at most latency packets ahead, one copy per packet in flight
+                auto &snapshot = m_snapshots[m_frame++ % m_snapshots.size()];
+                snapshot = m_field.transforms;
+                packet.Submit([this, &snapshot]
+                              { Draw(snapshot); });
+                return true;
+            }
+
+        private:
+            void Draw(std::vector<TransformComponent> &transforms)
+            {
+                Renderer2D::BeginScene(m_camera);
+                for (size_t i = 0; i < transforms.size(); i++)
+                    Renderer2D::DrawQuad(m_field.quads[i], transforms[i]);
+                Renderer2D::EndScene();
+            }
+
+        private:
+            QuadField m_field;
+            std::vector<std::vector<TransformComponent>> m_snapshots;
+            Ref<OrthographicCamera> m_camera;
+            uint64_t m_frame = 0;
+            float m_time = 0.f;
+        };
+
+        class FrameApp : public Application
+        {
+        public:
+            FrameApp(uint32_t quads, uint32_t latency, uint32_t frames)
+            {
+                SetRenderBackend(RenderBackend::Null);
+                SetRenderLatency(latency);
+                SetFrameLimit(frames);
+
+                m_appInitFn = [this, quads, latency]
+                {
+                    Renderer2D::Init({});
+                    m_layerStack.PushLayer(MakeRef<FrameLayer>(quads, latency));
+                };
+            }
+        };
+    }
+
+    //? whole Application::Run frames on the null backend, range(1) frames of latency, 0 updates and draws on one thread
+    //? with a render thread the frame time drops towards the longer of update and draw
+    static void BM_ApplicationFrame(benchmark::State &state)
+    {
+        constexpr uint32_t frames = 120;
+        uint32_t quads = uint32_t(state.range(0));
+        uint32_t latency = uint32_t(state.range(1));
+        double seconds = 0.0;
+
+        for (auto _ : state)
+        {
+            FrameApp app(quads, latency, frames);
+            Application::s_instance = &app;
+            app.Init();
+
+            auto start = std::chrono::steady_clock::now();
+            app.Run();
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            state.SetIterationTime(elapsed);
+            seconds += elapsed;
+            Application::s_instance = nullptr;
+        }
+
+        state.counters["frameMs"] = benchmark::Counter(1000.0 * seconds / (frames * state.iterations()));
+    }
+    BENCHMARK(BM_ApplicationFrame)->ArgNames({"quads", "latency"})->ArgsProduct({{10000, 100000}, {0, 1, 2}})->UseManualTime()->Iterations(3)->Unit(benchmark::kMillisecond);
+
+} // namespace ant::bench
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "Core/Core.hpp"
+#include "Render/Renderer.hpp"
+#include "Render/NullGl.hpp"
+#include "Camera/Camera.hpp"
+
+namespace ant::bench
+{
+    //? Renderer2D over NullGl, initialized again by every benchmark so the settings of one don't leak into the next
+    inline void InitRenderer(const Renderer2DSettings &settings)
+    {
+        Renderer2D::Init(settings);
+        NullGl::ResetStats();
+    }
+
+    inline Ref<OrthographicCamera> MakeCamera()
+    {
+        return MakeRef<OrthographicCamera>(-100.f, 100.f, -100.f, 100.f);
+    }
+
+    //? count untextured quads on a grid over the camera, depth grows with the index
+    struct QuadField
+    {
+        std::vector<Quad> quads;
+        std::vector<TransformComponent> transforms;
+
+        QuadField(uint32_t count)
+            : quads(count), transforms(count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                transforms[i].SetPosition({float(i % 200) - 100.f, float(i / 200 % 200) - 100.f, float(i) / count});
+                transforms[i].SetScale({0.5f, 0.5f});
+                quads[i].SetColor({float(i % 7) / 7.f, 0.5f, 1.f, 1.f});
+            }
+        }
+
+        void Draw()
+        {
+            for (size_t i = 0; i < quads.size(); i++)
+                Renderer2D::DrawQuad(quads[i], transforms[i]);
+        }
+    };
+
+} // namespace ant::bench
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <thread>
+#include "debug/Instrumentation.hpp"
+
+namespace ant::bench
+{
+    namespace
+    {
+        //? 1024 empty scopes per iteration, the same loop for every case
+        constexpr uint32_t s_scopes = 1024;
+
+        void Scopes()
+        {
+            for (uint32_t i = 0; i < s_scopes; i++)
+            {
+                CORE_PROFILE_SCOPE_CAT("Empty scope", Render);
+                benchmark::ClobberMemory();
+            }
+        }
+
+        void ReportRing(benchmark::State &state)
+        {
+            auto stats = Instrumentor::Get()->GetStats();
+            state.counters["recorded"] = stats.recorded;
+            state.counters["dropped"] = stats.dropped; // the writer drains every few ms, a tight loop outruns it
+            state.SetItemsProcessed(state.iterations() * s_scopes);
+        }
+    }
+
+    static void BM_ProfileClock(benchmark::State &state)
+    {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(Instrumentor::Now());
+    }
+    BENCHMARK(BM_ProfileClock);
+
+    //? no session, the cost every scope pays in a shipped build with ANT_PROFILE_LEVEL above 0
+    static void BM_ProfileScopeInactive(benchmark::State &state)
+    {
+        for (auto _ : state)
+            Scopes();
+
+        state.SetItemsProcessed(state.iterations() * s_scopes);
+    }
+    BENCHMARK(BM_ProfileScopeInactive);
+
+    //? a capture runs but the category is masked out
+    static void BM_ProfileScopeMasked(benchmark::State &state)
+    {
+        auto instrumentor = Instrumentor::Get();
+        instrumentor->SetCategoryMask(uint32_t(ProfileCategory::All) & ~uint32_t(ProfileCategory::Render));
+        instrumentor->BeginCapture("bench", 4);
+
+        for (auto _ : state)
+        {
+            Scopes();
+            instrumentor->MarkFrame();
+        }
+
+        instrumentor->EndSession();
+        instrumentor->SetCategoryMask(uint32_t(ProfileCategory::All));
+        state.SetItemsProcessed(state.iterations() * s_scopes);
+    }
+    BENCHMARK(BM_ProfileScopeMasked);
+
+    //? recorded into the ring, a capture of 4 frames keeps the writer in memory instead of on disk
+    //? every 8 frames the clock stops until the writer emptied the ring, dropped scopes would look cheaper
+    static void BM_ProfileScopeActive(benchmark::State &state)
+    {
+        auto instrumentor = Instrumentor::Get();
+        instrumentor->BeginCapture("bench", 4);
+        uint32_t frame = 0;
+
+        for (auto _ : state)
+        {
+            Scopes();
+            instrumentor->MarkFrame();
+
+            if (++frame % 8 == 0)
+            {
+                state.PauseTiming();
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                state.ResumeTiming();
+            }
+        }
+
+        ReportRing(state);
+        instrumentor->EndSession();
+    }
+    BENCHMARK(BM_ProfileScopeActive);
+
+} // namespace ant::bench
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include "Core/JobSystem.hpp"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace ant::bench
+{
+    namespace
+    {
+        //? range(0) threads including the caller, 1 runs everything inline without workers
+        struct ScopedJobSystem
+        {
+            explicit ScopedJobSystem(uint32_t threads)
+            {
+                if (threads > 1)
+                    JobSystem::Init(threads - 1);
+            }
+            ~ScopedJobSystem() { JobSystem::Shutdown(); }
+        };
+
+        void ThreadCounts(benchmark::internal::Benchmark *bench)
+        {
+            uint32_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+            for (uint32_t threads = 1; threads < hardware; threads *= 2)
+                bench->Arg(threads);
+            bench->Arg(hardware);
+        }
+    }
+
+    //? the ThreadPool it replaced was measured the same way, a million independent transforms split across threads
+    static void BM_JobSystemParallelForScaling(benchmark::State &state)
+    {
+        ScopedJobSystem jobs(uint32_t(state.range(0)));
+        std::vector<float> values(1 << 20, 1.f);
+
+        for (auto _ : state)
+        {
+            JobSystem::ParallelFor(uint32_t(values.size()), 4096, [&](uint32_t begin, uint32_t end)
+                                   {
+                                       for (uint32_t i = begin; i < end; i++)
+                                           values[i] = std::sqrt(values[i] * 1.0001f + 0.5f); });
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * values.size());
+    }
+    BENCHMARK(BM_JobSystemParallelForScaling)->ArgName("threads")->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+    //? cost of a job itself, empty jobs submitted from the main thread in rounds of range(1)
+    static void BM_JobSystemRunEmpty(benchmark::State &state)
+    {
+        ScopedJobSystem jobs(uint32_t(state.range(0)));
+        uint32_t round = uint32_t(state.range(1));
+
+        for (auto _ : state)
+        {
+            JobCounter counter;
+            for (uint32_t i = 0; i < round; i++)
+                JobSystem::Run([] {}, &counter);
+            JobSystem::Wait(counter);
+        }
+
+        state.SetItemsProcessed(state.iterations() * round);
+    }
+    BENCHMARK(BM_JobSystemRunEmpty)->ArgNames({"threads", "jobs"})->Args({1, 1000})->Args({2, 1000})->Args({4, 1000})->Args({4, 10000})->UseRealTime();
+
+} // namespace ant::bench
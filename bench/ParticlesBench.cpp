@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include "Headless.hpp"
+#include "Core/JobSystem.hpp"
+#include "Render/Particles.hpp"
+
+namespace ant::bench
+{
+    namespace
+    {
+        //? particles live for the whole run so the alive count stays at the capacity
+        void FillSystem(ParticleSystem &system)
+        {
+            ParticleProps props{};
+            props.velocity = {1.f, 0.5f};
+            props.velocityVariation = {2.f, 2.f};
+            props.size = {0.5f, 0.5f};
+            props.birthColor = {1.f, 0.5f, 0.f, 1.f};
+            props.deathColor = {0.f, 0.f, 1.f, 0.f};
+            props.lifeTime = 1e6f;
+            props.rotationVelocity = 90.f;
+            props.rotationVelocityVariation = 45.f;
+
+            for (uint32_t i = 0; i < system.GetCapacity(); i++)
+            {
+                props.position = {float(i % 1000) * 0.2f - 100.f, float(i / 1000) * 0.2f - 100.f};
+                system.Emit(props);
+            }
+        }
+    }
+
+    //? one 60 Hz frame of a million cpu particles, update and instance streaming
+    //? budgetPercent is the share of the 16.6 ms frame, range(0) worker threads for the instance writes (0 inline)
+    static void BM_Particles1MFrame(benchmark::State &state)
+    {
+        constexpr float frameSeconds = 1.f / 60.f;
+        uint32_t workers = uint32_t(state.range(0));
+        if (workers)
+            JobSystem::Init(workers);
+
+        Renderer2DSettings settings;
+        settings.quadsLimit = 1 << 16;
+        InitRenderer(settings);
+
+        auto camera = MakeCamera();
+        ParticleSystem system(1 << 20, ParticleBackend::Cpu);
+        FillSystem(system);
+
+        for (auto _ : state)
+        {
+            Renderer2D::OnUpdate();
+            system.OnUpdate(TimeStep(frameSeconds));
+
+            Renderer2D::BeginScene(camera);
+            system.OnDraw();
+            Renderer2D::EndScene();
+        }
+
+        state.counters["alive"] = system.GetAliveCount();
+        state.counters["drawCalls"] = Renderer2D::GetStats().drawCallsCount;
+        //? inverted rate, elapsed / (iterations * frameSeconds / 100)
+        state.counters["budgetPercent"] = benchmark::Counter(frameSeconds / 100.0, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+        state.SetItemsProcessed(state.iterations() * system.GetAliveCount());
+
+        JobSystem::Shutdown();
+    }
+    BENCHMARK(BM_Particles1MFrame)->ArgName("workers")->Arg(0)->Arg(3)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+    //? the update kernel alone, the part that has to fit next to the rest of the game
+    static void BM_Particles1MUpdate(benchmark::State &state)
+    {
+        ParticleSystem system(1 << 20, ParticleBackend::Cpu);
+        FillSystem(system);
+
+        for (auto _ : state)
+            system.OnUpdate(TimeStep(1.f / 60.f));
+
+        state.SetLabel(GetParticleKernel().name);
+        state.SetItemsProcessed(state.iterations() * system.GetAliveCount());
+    }
+    BENCHMARK(BM_Particles1MUpdate)->Unit(benchmark::kMillisecond);
+
+} // namespace ant::bench
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include "Render/QuadTransform.hpp"
+
+namespace ant::bench
+{
+    //? one full batch transformed over and over into a buffer the size of a 1000 quad stream region
+    static void BM_QuadTransformKernel(benchmark::State &state)
+    {
+        auto kernels = GetQuadTransformKernels();
+        if (size_t(state.range(0)) >= kernels.size())
+        {
+            state.SkipWithError("kernel not supported by this cpu");
+            return;
+        }
+
+        auto &kernel = kernels[state.range(0)];
+        state.SetLabel(kernel.name);
+
+        QuadTransformBatch batch;
+        for (uint32_t q = 0; q < QuadTransformBatch::capacity; q++)
+        {
+            TransformComponent transform;
+            transform.SetPosition({float(q), float(q), 0.f});
+            transform.SetRotation(0.3f * q);
+            transform.CalculateTranformationMatrix();
+            batch.Push({}, transform);
+        }
+
+        constexpr uint32_t quads = 1000 / QuadTransformBatch::capacity * QuadTransformBatch::capacity;
+        std::vector<Vertex> stream(4 * quads + 4); // rounded up to 16 bytes below, like a mapped region
+        Vertex *out = reinterpret_cast<Vertex *>((uintptr_t(stream.data()) + 15) & ~uintptr_t(15));
+
+        for (auto _ : state)
+        {
+            for (uint32_t q = 0; q < quads; q += QuadTransformBatch::capacity)
+                kernel.transform(batch, out + 4 * q);
+
+            FenceQuadTransforms();
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * quads);
+        state.SetBytesProcessed(state.iterations() * quads * 4 * sizeof(Vertex));
+    }
+    BENCHMARK(BM_QuadTransformKernel)->ArgName("kernel")->DenseRange(0, 2);
+
+} // namespace ant::bench
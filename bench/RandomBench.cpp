@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "Core/Random.hpp"
+
+namespace ant::bench
+{
+    namespace
+    {
+        void FillKernels(benchmark::internal::Benchmark *bench)
+        {
+            auto names = Random::GetKernelNames();
+            for (size_t i = 0; i < names.size(); i++)
+                bench->Arg(int64_t(i));
+        }
+    }
+
+    static void BM_RandomFloat(benchmark::State &state)
+    {
+        Random::Seed(1);
+        float sum = 0.f;
+
+        for (auto _ : state)
+            sum += Random::Float();
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_RandomFloat);
+
+    //? the generator Random wrapped before, a static mt19937 behind a uniform distribution
+    static void BM_Mt19937Float(benchmark::State &state)
+    {
+        std::mt19937 engine(1);
+        std::uniform_real_distribution<float> distribution(0.f, 1.f);
+        float sum = 0.f;
+
+        for (auto _ : state)
+            sum += distribution(engine);
+
+        benchmark::DoNotOptimize(sum);
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Mt19937Float);
+
+    //? range(0) indexes Random::GetKernelNames, 64k floats per fill
+    static void BM_RandomFillFloats(benchmark::State &state)
+    {
+        auto name = Random::GetKernelNames()[state.range(0)];
+        Random::SetKernel(name);
+        Random::Seed(1);
+        std::vector<float> values(1 << 16);
+
+        for (auto _ : state)
+        {
+            Random::FillFloats(values);
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        Random::SetKernel(Random::GetKernelNames().back());
+        state.SetLabel(name);
+        state.SetItemsProcessed(state.iterations() * values.size());
+    }
+    BENCHMARK(BM_RandomFillFloats)->ArgName("kernel")->Apply(FillKernels);
+
+    static void BM_Mt19937FillFloats(benchmark::State &state)
+    {
+        std::mt19937 engine(1);
+        std::uniform_real_distribution<float> distribution(0.f, 1.f);
+        std::vector<float> values(1 << 16);
+
+        for (auto _ : state)
+        {
+            for (auto &value : values)
+                value = distribution(engine);
+            benchmark::DoNotOptimize(values.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * values.size());
+    }
+    BENCHMARK(BM_Mt19937FillFloats);
+
+} // namespace ant::bench
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include "Headless.hpp"
+
+namespace ant::bench
+{
+    //? draw calls per frame for a batch capacity, the quads are fixed so only the split into batches changes
+    static void BM_DrawCallsPerCapacity(benchmark::State &state)
+    {
+        Renderer2DSettings settings;
+        settings.quadsLimit = state.range(0);
+        settings.instancing = state.range(1);
+        InitRenderer(settings);
+
+        auto camera = MakeCamera();
+        QuadField field(50000);
+
+        for (auto _ : state)
+        {
+            Renderer2D::OnUpdate();
+            Renderer2D::BeginScene(camera);
+            field.Draw();
+            Renderer2D::EndScene();
+        }
+
+        auto stats = Renderer2D::GetStats();
+        state.counters["drawCalls"] = stats.drawCallsCount;
+        state.counters["fenceStalls"] = stats.fenceStalls;
+        state.SetItemsProcessed(state.iterations() * field.quads.size());
+    }
+    BENCHMARK(BM_DrawCallsPerCapacity)->ArgNames({"capacity", "instancing"})->ArgsProduct({{250, 1000, 4000, 16000, 65536}, {0, 1}});
+
+    //? starts at the default capacity, the first frames grow the batch until the scene fits into one draw
+    static void BM_DrawCallsAutoGrow(benchmark::State &state)
+    {
+        Renderer2DSettings settings;
+        settings.autoGrow = true;
+        InitRenderer(settings);
+
+        auto camera = MakeCamera();
+        QuadField field(50000);
+
+        for (auto _ : state)
+        {
+            Renderer2D::OnUpdate();
+            Renderer2D::BeginScene(camera);
+            field.Draw();
+            Renderer2D::EndScene();
+        }
+
+        state.counters["drawCalls"] = Renderer2D::GetStats().drawCallsCount;
+        state.counters["quadsLimit"] = Renderer2D::GetQuadsLimit();
+        state.SetItemsProcessed(state.iterations() * field.quads.size());
+    }
+    BENCHMARK(BM_DrawCallsAutoGrow);
+
+    //? the gl work of a frame as NullGl counts it, batches are written through the persistently mapped streams
+    //? so a frame issues one draw per full or last batch, 6 vertices a quad and hands no bytes to gl
+    static void BM_BatchUpload(benchmark::State &state)
+    {
+        Renderer2DSettings settings;
+        settings.quadsLimit = state.range(1);
+        settings.instancing = state.range(2);
+        InitRenderer(settings);
+
+        auto camera = MakeCamera();
+        QuadField field(state.range(0));
+
+        for (auto _ : state)
+        {
+            Renderer2D::OnUpdate();
+            Renderer2D::BeginScene(camera);
+            field.Draw();
+            Renderer2D::EndScene();
+        }
+
+        uint64_t quads = field.quads.size();
+        uint64_t frames = state.iterations();
+        uint64_t quadBytes = settings.instancing ? sizeof(QuadInstance) : 4 * sizeof(Vertex);
+        auto stats = NullGl::GetStats();
+
+        if (stats.drawCalls != frames * ((quads + settings.quadsLimit - 1) / settings.quadsLimit))
+            state.SkipWithError("draw calls don't match the batch capacity");
+        else if (stats.vertices != frames * quads * 6)
+            state.SkipWithError("vertices don't match the quads drawn");
+        else if (stats.bytesUploaded || stats.bytesAllocated || stats.bytesMapped)
+            state.SkipWithError("a steady frame handed bytes to gl, the streams should be written through their mapping");
+        else if (Renderer2D::GetStats().bytesStreamed != quads * quadBytes)
+            state.SkipWithError("streamed bytes don't match the quads drawn");
+
+        state.counters["drawCalls"] = benchmark::Counter(stats.drawCalls, benchmark::Counter::kAvgIterations);
+        state.counters["glCalls"] = benchmark::Counter(stats.calls, benchmark::Counter::kAvgIterations);
+        state.counters["bytesStreamed"] = Renderer2D::GetStats().bytesStreamed;
+        state.SetBytesProcessed(state.iterations() * quads * quadBytes);
+        state.SetItemsProcessed(state.iterations() * quads);
+    }
+    BENCHMARK(BM_BatchUpload)->ArgNames({"quads", "capacity", "instancing"})->ArgsProduct({{10000, 50000}, {1000, 16000}, {0, 1}});
+
+} // namespace ant::bench
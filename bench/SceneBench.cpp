@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include "Scene/Scene.hpp"
+#include "Scene/Components.hpp"
+
+namespace ant::bench
+{
+    //? 100k nodes in a 4-ary tree, range(0) per mille of the nodes move every frame, spread over all depths
+    static void BM_SceneUpdateTransforms(benchmark::State &state)
+    {
+        constexpr uint32_t nodes = 100000;
+        Scene scene;
+        std::vector<Entity> entities;
+        entities.reserve(nodes);
+
+        for (uint32_t i = 0; i < nodes; i++)
+        {
+            auto entity = scene.RegisterEntity();
+            entity.AddComponent<TransformComponent>().SetPosition({1.f, 0.f, 0.f});
+            if (i)
+                entity.SetParent(entities[(i - 1) / 4]);
+            entities.push_back(entity);
+        }
+
+        scene.UpdateTransforms();
+
+        uint32_t moving = nodes * state.range(0) / 1000;
+        uint32_t stride = moving ? nodes / moving : 0;
+        uint64_t recomputed = 0;
+        float offset = 0.f;
+
+        for (auto _ : state)
+        {
+            offset += 1.f;
+            for (uint32_t i = 0; i < moving; i++)
+                entities[i * stride].GetComponent<TransformComponent>().SetPosition({1.f, offset, 0.f});
+
+            recomputed += scene.UpdateTransforms();
+        }
+
+        state.counters["recomputed"] = benchmark::Counter(recomputed, benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations() * nodes);
+    }
+    BENCHMARK(BM_SceneUpdateTransforms)->ArgName("movingPerMille")->Arg(0)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+} // namespace ant::bench
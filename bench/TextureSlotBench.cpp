@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <unordered_map>
+#include "Headless.hpp"
+#include "Scene/Components.hpp"
+
+namespace ant::bench
+{
+    static constexpr uint32_t s_quads = 20000;
+    static constexpr uint32_t s_slotLimit = 32;
+
+    //? the slot bookkeeping alone, without gl, so the two lookups compare directly
+    struct SlotTexture
+    {
+        uint32_t epoch = 0;
+        uint32_t slot = 0;
+    };
+
+    //? what Renderer2D did before: a map of the textures in the batch, cleared when the slots run out
+    static void BM_TextureSlotHashed(benchmark::State &state)
+    {
+        std::vector<SlotTexture> textures(state.range(0));
+        std::unordered_map<SlotTexture *, bool> used;
+        uint32_t count = 1;
+        uint32_t flushes = 0;
+
+        for (auto _ : state)
+        {
+            for (uint32_t i = 0; i < s_quads; i++)
+            {
+                SlotTexture *texture = &textures[i % textures.size()];
+
+                if (count >= s_slotLimit)
+                {
+                    used.clear();
+                    count = 1;
+                    flushes++;
+                }
+
+                bool &active = used[texture];
+                if (!active)
+                {
+                    texture->slot = count++;
+                    active = true;
+                }
+
+                benchmark::DoNotOptimize(texture->slot);
+            }
+        }
+
+        state.counters["flushes"] = benchmark::Counter(flushes, benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations() * s_quads);
+    }
+    BENCHMARK(BM_TextureSlotHashed)->Arg(8)->Arg(32)->Arg(200);
+
+    //? Renderer2D::GetTextureSlot, the texture remembers the batch epoch it got its slot in
+    static void BM_TextureSlotEpoch(benchmark::State &state)
+    {
+        std::vector<SlotTexture> textures(state.range(0));
+        uint32_t epoch = 1;
+        uint32_t count = 1;
+        uint32_t flushes = 0;
+
+        for (auto _ : state)
+        {
+            for (uint32_t i = 0; i < s_quads; i++)
+            {
+                SlotTexture *texture = &textures[i % textures.size()];
+
+                if (texture->epoch != epoch)
+                {
+                    if (count >= s_slotLimit)
+                    {
+                        epoch++;
+                        count = 1;
+                        flushes++;
+                    }
+
+                    texture->slot = count++;
+                    texture->epoch = epoch;
+                }
+
+                benchmark::DoNotOptimize(texture->slot);
+            }
+        }
+
+        state.counters["flushes"] = benchmark::Counter(flushes, benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations() * s_quads);
+    }
+    BENCHMARK(BM_TextureSlotEpoch)->Arg(8)->Arg(32)->Arg(200);
+
+    //? the whole textured draw through Renderer2D, binds show what the bound unit table saves between batches
+    static void BM_TexturedQuads(benchmark::State &state)
+    {
+        Renderer2DSettings settings;
+        settings.quadsLimit = s_quads;
+        InitRenderer(settings);
+
+        auto camera = MakeCamera();
+        QuadField field(s_quads);
+        std::vector<TextureComponent> textures(state.range(0));
+
+        for (auto &texture : textures)
+            texture.Texture = MakeRef<SubTexture>(Texture::Create(4, 4));
+
+        for (auto _ : state)
+        {
+            Renderer2D::OnUpdate();
+            Renderer2D::BeginScene(camera);
+
+            for (uint32_t i = 0; i < s_quads; i++)
+                Renderer2D::DrawTexturedQuad(field.quads[i], field.transforms[i], textures[i % textures.size()]);
+
+            Renderer2D::EndScene();
+        }
+
+        auto stats = Renderer2D::GetStats();
+        state.counters["textureFlushes"] = stats.textureFlushes;
+        state.counters["textureBinds"] = stats.textureBinds;
+        state.SetItemsProcessed(state.iterations() * s_quads);
+    }
+    BENCHMARK(BM_TexturedQuads)->Arg(8)->Arg(32)->Arg(200);
+
+} // namespace ant::bench
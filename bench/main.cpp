@@ -0,0 +1,21 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/logger.h>
+#include "Core/Logger.hpp"
+#include "Render/NullGl.hpp"
+
+//? every gl call lands in NullGl, the benchmarks measure the cpu side of the engine and read the gl work from NullGl::GetStats
+//! run from the repository root, Renderer2D loads its shaders from shaders/
+int main(int argc, char **argv)
+{
+    ant::Logger::Init();
+    ant::Logger::GetCoreLogger()->set_level(spdlog::level::warn);
+    ant::NullGl::Install();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,47 @@
+#vertexShader
+#version 450 core
+
+layout(location = 0) in vec3 a_translation;
+layout(location = 1) in vec2 a_xAxis;
+layout(location = 2) in vec2 a_yAxis;
+layout(location = 3) in uint a_color;
+layout(location = 4) in uint a_textureId;
+layout(location = 5) in vec4 a_atlasRect;
+
+uniform mat4 u_ViewProjectionMatrix;
+
+out vec4 v_color;
+out vec2 v_textureCoordinate;
+flat out uint v_textureId;
+
+// same corner order as Quad::m_vertices expanded through Quad::s_indices
+const vec2 c_corners[6] = vec2[](
+    vec2(-0.5, 0.5), vec2(-0.5, -0.5), vec2(0.5, -0.5),
+    vec2(0.5, -0.5), vec2(0.5, 0.5), vec2(-0.5, 0.5));
+
+void main()
+{
+    vec2 corner = c_corners[gl_VertexID];
+    vec2 world = a_xAxis * corner.x + a_yAxis * corner.y + a_translation.xy;
+
+    gl_Position = u_ViewProjectionMatrix * vec4(world, a_translation.z, 1.0);
+    v_color = unpackUnorm4x8(a_color);
+    v_textureCoordinate = mix(a_atlasRect.xy, a_atlasRect.zw, corner + 0.5);
+    v_textureId = a_textureId;
+}
+
+#fragmentShader
+#version 450 core
+
+in vec4 v_color;
+in vec2 v_textureCoordinate;
+flat in uint v_textureId;
+
+uniform sampler2D u_textures[32];
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+    color = texture(u_textures[v_textureId], v_textureCoordinate) * v_color;
+}
@@ -0,0 +1,63 @@
+#vertexShader
+#version 450 core
+
+struct Particle
+{
+    vec2 position;
+    vec2 velocity;
+    vec2 size;
+    float rotation;
+    float rotationVelocity;
+    float life;
+    float inverseLifeTime;
+    uint birthColor;
+    uint deathColor;
+};
+
+layout(std430, binding = 4) readonly buffer Particles { Particle particles[]; };
+
+uniform mat4 u_ViewProjectionMatrix;
+uniform float u_depth;
+uniform int u_capacity;
+
+out vec4 v_color;
+
+const vec2 c_corners[6] = vec2[](
+    vec2(-0.5, 0.5), vec2(-0.5, -0.5), vec2(0.5, -0.5),
+    vec2(0.5, -0.5), vec2(0.5, 0.5), vec2(-0.5, 0.5));
+
+// one instance per particle, sized and colored from the remaining life like ParticleSystem::WriteInstances
+void main()
+{
+    if (gl_InstanceID >= u_capacity)
+    {
+        gl_Position = vec4(0.0, 0.0, 0.0, 0.0); // appended past the end of a full buffer
+        return;
+    }
+
+    Particle p = particles[gl_InstanceID];
+    float t = p.life * p.inverseLifeTime;
+    vec2 size = p.size * t;
+    float sine = sin(p.rotation);
+    float cosine = cos(p.rotation);
+
+    vec2 xAxis = vec2(cosine, -sine) * size.x;
+    vec2 yAxis = vec2(sine, cosine) * size.y;
+    vec2 corner = c_corners[gl_VertexID];
+    vec2 world = xAxis * corner.x + yAxis * corner.y + p.position;
+
+    gl_Position = u_ViewProjectionMatrix * vec4(world, u_depth, 1.0);
+    v_color = mix(unpackUnorm4x8(p.deathColor), unpackUnorm4x8(p.birthColor), t);
+}
+
+#fragmentShader
+#version 450 core
+
+in vec4 v_color;
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+    color = v_color;
+}
@@ -0,0 +1,64 @@
+#computeShader
+#version 450 core
+
+layout(local_size_x = 256) in;
+
+// same layout as GpuParticle
+struct Particle
+{
+    vec2 position;
+    vec2 velocity;
+    vec2 size;
+    float rotation;
+    float rotationVelocity;
+    float life;
+    float inverseLifeTime;
+    uint birthColor;
+    uint deathColor;
+};
+
+// DrawArraysIndirectCommand, instanceCount is the number of particles in the matching buffer
+struct DrawCommand
+{
+    uint count;
+    uint instanceCount;
+    uint first;
+    uint baseInstance;
+};
+
+layout(std430, binding = 4) readonly buffer InParticles { Particle inParticles[]; };
+layout(std430, binding = 5) writeonly buffer OutParticles { Particle outParticles[]; };
+layout(std430, binding = 6) readonly buffer EmittedParticles { Particle emitted[]; };
+layout(std430, binding = 7) buffer DrawCommands { DrawCommand commands[2]; };
+
+uniform float u_dt;
+uniform int u_emitCount;
+uniform int u_input;
+uniform int u_capacity;
+
+// alive particles of the input buffer, then the ones emitted since the last update
+// survivors are appended to the output buffer, same integration as ParticleKernel
+void main()
+{
+    uint id = gl_GlobalInvocationID.x;
+    uint inputCount = min(commands[u_input].instanceCount, uint(u_capacity));
+
+    Particle p;
+    if (id < inputCount)
+        p = inParticles[id];
+    else if (id < inputCount + uint(u_emitCount))
+        p = emitted[id - inputCount];
+    else
+        return;
+
+    p.position += p.velocity * u_dt;
+    p.rotation += p.rotationVelocity * u_dt;
+    p.life -= u_dt;
+
+    if (p.life <= 0.0)
+        return;
+
+    uint index = atomicAdd(commands[1 - u_input].instanceCount, 1u);
+    if (index < uint(u_capacity))
+        outParticles[index] = p;
+}
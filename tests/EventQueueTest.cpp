@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "Input/EventQueue.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        Event Move(double x) { return MouseMovedEvent({x, 0.0}); }
+        Event Press() { return MouseButtonPressedEvent(MouseButtonCode::BUTTON_LEFT, KeyModifier::NONE); }
+        Event Release() { return MouseButtonReleasedEvent(MouseButtonCode::BUTTON_LEFT, KeyModifier::NONE); }
+
+        //? type and x of a move, -1 for the other events
+        struct Dispatched
+        {
+            EventType type;
+            double x;
+            bool operator==(const Dispatched &) const = default;
+        };
+
+        std::vector<Dispatched> DrainAll(EventQueue &queue)
+        {
+            std::vector<Dispatched> events;
+            queue.Drain([&](Event &event)
+                        {
+                            auto move = event.As<MouseMovedEvent>();
+                            events.push_back({event.GetEventType(), move ? move->GetMousePos().x : -1.0}); });
+            return events;
+        }
+    }
+
+    TEST(EventQueue, MovesCoalesceOnlyBetweenClicks)
+    {
+        EventQueue queue;
+        for (auto &event : {Move(1), Move(2), Press(), Move(3), Release(), Move(4), Move(5)})
+            ASSERT_TRUE(queue.Push(event));
+
+        //? a click sees the position right before it, only runs of moves collapse
+        std::vector<Dispatched> expected = {
+            {EventType::MouseMoved, 2.0},
+            {EventType::MouseButtonPressed, -1.0},
+            {EventType::MouseMoved, 3.0},
+            {EventType::MouseButtonReleased, -1.0},
+            {EventType::MouseMoved, 5.0}};
+        EXPECT_EQ(DrainAll(queue), expected);
+
+        auto stats = queue.GetStats();
+        EXPECT_EQ(stats.pushed, 7u);
+        EXPECT_EQ(stats.dispatched, 5u);
+        EXPECT_EQ(stats.coalesced, 2u);
+    }
+
+    TEST(EventQueue, ResizesCoalesceButMovesDoNotMergeWithThem)
+    {
+        EventQueue queue;
+        queue.Push(WindowRezisedEvent({100, 100}));
+        queue.Push(WindowRezisedEvent({200, 150}));
+        queue.Push(Move(1));
+        queue.Push(WindowRezisedEvent({300, 200}));
+        queue.Push(WindowClosedEvent());
+
+        std::vector<WindowRezisedEvent::WindowSize> sizes;
+        uint32_t count = 0;
+        queue.Drain([&](Event &event)
+                    {
+                        count++;
+                        if (auto resize = event.As<WindowRezisedEvent>())
+                            sizes.push_back(resize->GetWindowSize()); });
+
+        EXPECT_EQ(count, 4u);
+        ASSERT_EQ(sizes.size(), 2u);
+        EXPECT_EQ(sizes[0].x, 200);
+        EXPECT_EQ(sizes[1].x, 300);
+    }
+
+    TEST(EventQueue, FullQueueDropsNewEvents)
+    {
+        EventQueue queue(4);
+        for (int i = 0; i < 4; i++)
+            ASSERT_TRUE(queue.Push(KeyPressedEvent(KeyCode(int(KeyCode::KEY_A) + i), KeyModifier::NONE)));
+
+        EXPECT_FALSE(queue.Push(Press()));
+        EXPECT_FALSE(queue.Push(Release()));
+        EXPECT_EQ(queue.GetStats().dropped, 2u);
+
+        //? the oldest events survive, in order
+        std::vector<KeyCode> keys;
+        queue.Drain([&](Event &event)
+                    { keys.push_back(event.As<KeyPressedEvent>()->GetKeyCode()); });
+        ASSERT_EQ(keys.size(), 4u);
+        for (int i = 0; i < 4; i++)
+            EXPECT_EQ(keys[i], KeyCode(int(KeyCode::KEY_A) + i));
+
+        //? drained cells are free again, for more than one lap
+        for (int lap = 0; lap < 3; lap++)
+        {
+            for (int i = 0; i < 4; i++)
+                ASSERT_TRUE(queue.Push(Press()));
+            EXPECT_EQ(DrainAll(queue).size(), 4u);
+        }
+        EXPECT_EQ(queue.GetStats().dropped, 2u);
+    }
+
+    TEST(EventQueue, EventsPushedWhileDrainingWaitForTheNextDrain)
+    {
+        EventQueue queue;
+        queue.Push(Press());
+
+        uint32_t first = 0;
+        queue.Drain([&](Event &)
+                    { first++; queue.Push(Release()); });
+        EXPECT_EQ(first, 1u);
+
+        auto second = DrainAll(queue);
+        ASSERT_EQ(second.size(), 1u);
+        EXPECT_EQ(second[0].type, EventType::MouseButtonReleased);
+    }
+
+    TEST(EventQueue, ProducersKeepTheirOrder)
+    {
+        constexpr int producers = 4;
+        constexpr int perProducer = 10000;
+        EventQueue queue(producers * perProducer);
+
+        //? scroll x carries the producer, y the sequence number, scrolls never coalesce
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; p++)
+            threads.emplace_back([&queue, p]
+                                 {
+                                     for (int i = 0; i < perProducer; i++)
+                                         queue.Push(MouseScrolledEvent({double(p), double(i)})); });
+        for (auto &thread : threads)
+            thread.join();
+
+        std::vector<int> next(producers, 0);
+        queue.Drain([&](Event &event)
+                    {
+                        auto &offset = event.As<MouseScrolledEvent>()->GetScrollOffset();
+                        int p = int(offset.x);
+                        EXPECT_EQ(int(offset.y), next[p]);
+                        next[p] = int(offset.y) + 1; });
+
+        for (int p = 0; p < producers; p++)
+            EXPECT_EQ(next[p], perProducer);
+        EXPECT_EQ(queue.GetStats().dropped, 0u);
+    }
+
+} // namespace ant
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "Core/JobSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace ant
+{
+    namespace
+    {
+        class JobSystemTest : public testing::Test
+        {
+        protected:
+            void SetUp() override { JobSystem::Init(3); }
+            void TearDown() override { JobSystem::Shutdown(); }
+        };
+
+        void Sleep(int microseconds) { std::this_thread::sleep_for(std::chrono::microseconds(microseconds)); }
+    }
+
+    TEST_F(JobSystemTest, ParallelForVisitsEveryIndexOnce)
+    {
+        std::vector<std::atomic<uint32_t>> hits(100003);
+
+        JobSystem::ParallelFor(uint32_t(hits.size()), 64, [&](uint32_t begin, uint32_t end)
+                               {
+                                   for (uint32_t i = begin; i < end; i++)
+                                       hits[i].fetch_add(1, std::memory_order_relaxed); });
+
+        for (auto &hit : hits)
+            ASSERT_EQ(hit.load(), 1u);
+    }
+
+    TEST_F(JobSystemTest, DependentJobStartsAfterItsDependency)
+    {
+        JobCounter first, second;
+        std::atomic<uint32_t> finished = 0;
+        uint32_t seen = 0;
+
+        for (int i = 0; i < 32; i++)
+            JobSystem::Run([&]
+                           { Sleep(100); finished.fetch_add(1); },
+                           &first);
+
+        JobSystem::Run([&]
+                       { seen = finished.load(); },
+                       &second, &first);
+
+        JobSystem::Wait(second);
+        EXPECT_TRUE(first.IsDone());
+        EXPECT_EQ(seen, 32u);
+    }
+
+    TEST_F(JobSystemTest, WorkersStealFromTheSubmittingThread)
+    {
+        JobCounter counter;
+        std::vector<std::thread::id> ranOn(64);
+
+        for (uint32_t i = 0; i < ranOn.size(); i++)
+            JobSystem::Run([&, i]
+                           { Sleep(1000); ranOn[i] = std::this_thread::get_id(); },
+                           &counter);
+
+        JobSystem::Wait(counter);
+
+        //? only the main deque held jobs, everything the workers ran was stolen
+        uint32_t elsewhere = std::count_if(ranOn.begin(), ranOn.end(), [](auto id)
+                                           { return id != std::this_thread::get_id(); });
+        EXPECT_GT(elsewhere, 0u);
+        EXPECT_EQ(JobSystem::GetStats().steals, elsewhere);
+        EXPECT_EQ(JobSystem::GetStats().jobsExecuted, ranOn.size());
+    }
+
+    TEST_F(JobSystemTest, MoreJobsInFlightThanRecords)
+    {
+        //? three times the record ring, jobs past it run inline instead of overwriting queued ones
+        constexpr uint64_t jobs = 3 * WorkStealingDeque::capacity + 1;
+        JobCounter counter;
+        std::atomic<uint64_t> sum = 0;
+
+        for (uint64_t i = 1; i <= jobs; i++)
+            JobSystem::Run([&sum, i]
+                           { sum.fetch_add(i, std::memory_order_relaxed); },
+                           &counter);
+
+        JobSystem::Wait(counter);
+        EXPECT_EQ(sum.load(), jobs * (jobs + 1) / 2);
+    }
+
+    TEST_F(JobSystemTest, ThreadsOutsideThePoolRunInline)
+    {
+        std::thread outside([]
+                            {
+                                JobCounter counter;
+                                std::thread::id ranOn;
+                                JobSystem::Run([&] { ranOn = std::this_thread::get_id(); }, &counter);
+                                JobSystem::Wait(counter);
+                                EXPECT_EQ(ranOn, std::this_thread::get_id()); });
+        outside.join();
+
+        std::thread registered([]
+                               {
+                                   JobSystem::RegisterThread();
+                                   std::atomic<uint32_t> visited = 0;
+                                   JobSystem::ParallelFor(10000, 16, [&](uint32_t begin, uint32_t end)
+                                                          { visited.fetch_add(end - begin); });
+                                   JobSystem::UnregisterThread();
+                                   EXPECT_EQ(visited.load(), 10000u); });
+        registered.join();
+    }
+
+} // namespace ant
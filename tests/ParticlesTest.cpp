@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include "Core/Random.hpp"
+#include "Graphics/Window.hpp"
+#include "Render/Particles.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        //? four lifetimes, the shortest two run out during the test, positions on a grid one unit apart
+        void EmitGrid(ParticleSystem &system, uint32_t count)
+        {
+            Random::Seed(1234); // both systems roll the same variations
+
+            ParticleProps props{};
+            props.velocity = {1.f, -0.5f};
+            props.velocityVariation = {0.5f, 0.5f};
+            props.size = {0.25f, 0.25f};
+            props.birthColor = {1.f, 1.f, 1.f, 1.f};
+            props.deathColor = {1.f, 0.f, 0.f, 0.f};
+            props.rotationVelocity = 30.f;
+            props.rotationVelocityVariation = 20.f;
+
+            const float lifeTimes[] = {0.26f, 0.41f, 1.f, 2.f};
+            for (uint32_t i = 0; i < count; i++)
+            {
+                props.position = {float(i % 64), float(i / 64)};
+                props.lifeTime = lifeTimes[i % 4];
+                system.Emit(props);
+            }
+        }
+
+        //? indices of the alive particles ordered by position, the backends pack their particles differently
+        std::vector<uint32_t> SortedByPosition(const ParticleSystem &system)
+        {
+            auto &p = system.GetParticles();
+            std::vector<uint32_t> order(system.GetAliveCount());
+            std::iota(order.begin(), order.end(), 0u);
+            std::sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r)
+                      { return p.y[l] != p.y[r] ? p.y[l] < p.y[r] : p.x[l] < p.x[r]; });
+            return order;
+        }
+    }
+
+    //? needs a real gl 4.5 context (llvmpipe through osmesa or egl is enough), skipped without one
+    TEST(ParticlesCompute, MatchesTheCpuBackend)
+    {
+        Window window;
+        window.Init({64, 64, "ParticlesTest", false, false, RenderBackend::Offscreen});
+        if (!window.IsOpen())
+            GTEST_SKIP() << "no offscreen gl context";
+        if (!ParticleComputeBackend::IsSupported())
+            GTEST_SKIP() << "gl 4.5 missing";
+
+        constexpr uint32_t count = 4096;
+        ParticleSystem cpu(count, ParticleBackend::Cpu);
+        ParticleSystem gpu(count, ParticleBackend::Compute);
+        ASSERT_EQ(gpu.GetBackend(), ParticleBackend::Compute);
+
+        EmitGrid(cpu, count);
+        EmitGrid(gpu, count);
+
+        for (int frame = 0; frame < 30; frame++)
+        {
+            cpu.OnUpdate(TimeStep(1.f / 60.f));
+            gpu.OnUpdate(TimeStep(1.f / 60.f));
+        }
+
+        gpu.ReadBack();
+        ASSERT_EQ(cpu.GetAliveCount(), count / 2);
+        ASSERT_EQ(gpu.GetAliveCount(), cpu.GetAliveCount());
+
+        //? fma on the cpu kernels and the gpu round differently, a few ulps over 30 steps
+        auto cpuOrder = SortedByPosition(cpu);
+        auto gpuOrder = SortedByPosition(gpu);
+        auto &c = cpu.GetParticles();
+        auto &g = gpu.GetParticles();
+        constexpr float tolerance = 1e-4f;
+
+        for (uint32_t k = 0; k < cpuOrder.size(); k++)
+        {
+            uint32_t i = cpuOrder[k], j = gpuOrder[k];
+            ASSERT_NEAR(c.x[i], g.x[j], tolerance);
+            ASSERT_NEAR(c.y[i], g.y[j], tolerance);
+            ASSERT_NEAR(c.velocityX[i], g.velocityX[j], tolerance);
+            ASSERT_NEAR(c.velocityY[i], g.velocityY[j], tolerance);
+            ASSERT_NEAR(c.rotation[i], g.rotation[j], tolerance);
+            ASSERT_NEAR(c.life[i], g.life[j], tolerance);
+            ASSERT_NEAR(c.inverseLifeTime[i], g.inverseLifeTime[j], tolerance);
+        }
+    }
+
+} // namespace ant
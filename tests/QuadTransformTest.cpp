@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "Render/QuadTransform.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        //? quads with every kind of affine, the vertices carry distinct attributes so a misplaced lane shows
+        QuadTransformBatch MakeBatch(uint32_t count)
+        {
+            QuadTransformBatch batch;
+
+            for (uint32_t q = 0; q < count; q++)
+            {
+                TransformComponent transform;
+                transform.SetPosition({q * 3.5f - 10.f, 7.f - q * 1.25f, 0.1f * q});
+                transform.SetRotation(0.7f * q);
+                transform.SetScale({1.f + q, 0.5f + 0.25f * q});
+                transform.CalculateTranformationMatrix();
+
+                std::array<Vertex, 4> vertices;
+                for (uint32_t k = 0; k < 4; k++)
+                {
+                    float id = float(q * 4 + k);
+                    vertices[k].color = {id, id + 0.25f, id + 0.5f, id + 0.75f};
+                    vertices[k].textureCoordinate = {id * 2.f, id * 3.f};
+                    vertices[k].textureId = id;
+                }
+
+                batch.Push(vertices, transform);
+            }
+
+            return batch;
+        }
+
+        void ExpectSameVertices(const Vertex *expected, const Vertex *actual, uint32_t count, const char *kernel)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                //? fma rounds once where the others round twice
+                for (int c = 0; c < 4; c++)
+                    EXPECT_NEAR(expected[i].position[c], actual[i].position[c], 1e-4f) << kernel << " vertex " << i;
+
+                EXPECT_EQ(expected[i].color, actual[i].color) << kernel << " vertex " << i;
+                EXPECT_EQ(expected[i].textureCoordinate, actual[i].textureCoordinate) << kernel << " vertex " << i;
+                EXPECT_EQ(expected[i].textureId, actual[i].textureId) << kernel << " vertex " << i;
+            }
+        }
+    }
+
+    TEST(QuadTransform, KernelsMatchTheScalarKernel)
+    {
+        auto kernels = GetQuadTransformKernels();
+        ASSERT_STREQ(kernels[0].name, "scalar");
+
+        //? full and partial batches, the simd kernels run whole lanes either way
+        for (uint32_t count : {1u, 3u, 4u, 5u, 8u})
+        {
+            auto batch = MakeBatch(count);
+
+            alignas(16) Vertex expected[4 * QuadTransformBatch::capacity];
+            kernels[0].transform(batch, expected);
+
+            for (auto &kernel : kernels.subspan(1))
+            {
+                //? the mapped stream is 16 byte aligned, the unaligned store path is checked too
+                alignas(16) Vertex aligned[4 * QuadTransformBatch::capacity];
+                alignas(16) Vertex unaligned[4 * QuadTransformBatch::capacity + 1];
+                kernel.transform(batch, aligned);
+                kernel.transform(batch, unaligned + 1);
+                FenceQuadTransforms();
+
+                ExpectSameVertices(expected, aligned, 4 * count, kernel.name);
+                ExpectSameVertices(expected, unaligned + 1, 4 * count, kernel.name);
+            }
+        }
+    }
+
+    TEST(QuadTransform, ScalarKernelPlacesTheCorners)
+    {
+        QuadTransformBatch batch;
+        TransformComponent transform;
+        transform.SetPosition({10.f, 20.f, 0.5f});
+        transform.SetScale({2.f, 4.f});
+        transform.CalculateTranformationMatrix();
+        batch.Push({}, transform);
+
+        Vertex out[4];
+        GetQuadTransformKernels()[0].transform(batch, out);
+
+        //? Quad corner order: top left, bottom left, bottom right, top right
+        EXPECT_EQ(out[0].position, glm::vec4(9.f, 22.f, 0.5f, 1.f));
+        EXPECT_EQ(out[1].position, glm::vec4(9.f, 18.f, 0.5f, 1.f));
+        EXPECT_EQ(out[2].position, glm::vec4(11.f, 18.f, 0.5f, 1.f));
+        EXPECT_EQ(out[3].position, glm::vec4(11.f, 22.f, 0.5f, 1.f));
+    }
+
+} // namespace ant
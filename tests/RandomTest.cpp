@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "Core/Random.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        //? 8 lanes per block, 1003 floats leave a tail of 3
+        std::vector<float> Fill(const char *kernel, uint64_t seed, size_t count = 1003)
+        {
+            EXPECT_TRUE(Random::SetKernel(kernel));
+            Random::Seed(seed);
+            Random::SetStream(0);
+
+            std::vector<float> values(count);
+            Random::FillFloats(values);
+            return values;
+        }
+
+        class RandomTest : public testing::Test
+        {
+        protected:
+            void TearDown() override { Random::SetKernel(Random::GetKernelNames().back()); }
+        };
+    }
+
+    TEST_F(RandomTest, EveryFillKernelDrawsTheSameNumbers)
+    {
+        auto names = Random::GetKernelNames();
+        ASSERT_STREQ(names.front(), "scalar");
+        auto expected = Fill("scalar", 42);
+
+        for (auto value : expected)
+        {
+            ASSERT_GE(value, 0.f);
+            ASSERT_LT(value, 1.f);
+        }
+
+        for (auto name : names)
+        {
+            auto values = Fill(name, 42);
+            for (size_t i = 0; i < values.size(); i++)
+                ASSERT_EQ(values[i], expected[i]) << name << " differs at " << i;
+
+            //? the next fill continues the lanes, it has to match too
+            std::vector<float> next(64), expectedNext(64);
+            Random::FillFloats(next);
+            Fill("scalar", 42);
+            Random::FillFloats(expectedNext);
+            EXPECT_EQ(next, expectedNext) << name;
+        }
+    }
+
+    TEST_F(RandomTest, SameSeedReplaysTheSequence)
+    {
+        auto first = Fill(Random::GetKernelName(), 7, 64);
+        uint32_t firstInt = Random::UInt();
+        float firstFloat = Random::Float();
+
+        auto second = Fill(Random::GetKernelName(), 7, 64);
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(Random::UInt(), firstInt);
+        EXPECT_EQ(Random::Float(), firstFloat);
+
+        EXPECT_NE(Fill(Random::GetKernelName(), 8, 64), first);
+    }
+
+    TEST_F(RandomTest, BoundedDrawsStayInRange)
+    {
+        Random::Seed(3);
+        for (int i = 0; i < 10000; i++)
+        {
+            ASSERT_LT(Random::UInt(10), 10u);
+            float value = Random::Float(-2.f, 5.f);
+            ASSERT_GE(value, -2.f);
+            ASSERT_LT(value, 5.f);
+        }
+    }
+
+    TEST_F(RandomTest, UnknownKernelIsRefused)
+    {
+        EXPECT_FALSE(Random::SetKernel("neon"));
+    }
+
+} // namespace ant
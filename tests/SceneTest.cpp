@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "Scene/Scene.hpp"
+#include "Scene/Components.hpp"
+#include "Render/Renderer.hpp"
+#include "Render/NullGl.hpp"
+#include "Camera/Camera.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        Entity MakeNode(Scene &scene, const glm::vec3 &position)
+        {
+            auto entity = scene.RegisterEntity();
+            entity.AddComponent<TransformComponent>().SetPosition(position);
+            return entity;
+        }
+
+        glm::vec2 WorldPosition(Entity entity)
+        {
+            return entity.GetComponent<TransformComponent>().GetAffine()[2];
+        }
+    }
+
+    TEST(Scene, ChildrenFollowTheirParent)
+    {
+        Scene scene;
+        auto root = MakeNode(scene, {10.f, 0.f, 0.f});
+        auto child = MakeNode(scene, {1.f, 0.f, 0.f});
+        auto grandChild = MakeNode(scene, {0.f, 1.f, 0.f});
+
+        child.SetParent(root);
+        grandChild.SetParent(child);
+        EXPECT_EQ(scene.UpdateTransforms(), 3u);
+        EXPECT_EQ(WorldPosition(grandChild), glm::vec2(11.f, 1.f));
+
+        root.GetComponent<TransformComponent>().SetPosition({20.f, 0.f, 0.f});
+        EXPECT_EQ(scene.UpdateTransforms(), 3u);
+        EXPECT_EQ(WorldPosition(grandChild), glm::vec2(21.f, 1.f));
+    }
+
+    TEST(Scene, OnlyDirtySubtreesAreRecomputed)
+    {
+        Scene scene;
+        auto root = MakeNode(scene, {0.f, 0.f, 0.f});
+        std::vector<Entity> branches;
+
+        for (int i = 0; i < 4; i++)
+        {
+            auto branch = MakeNode(scene, {float(i), 0.f, 0.f});
+            branch.SetParent(root);
+            branches.push_back(branch);
+
+            for (int j = 0; j < 3; j++)
+                MakeNode(scene, {0.f, float(j), 0.f}).SetParent(branch);
+        }
+
+        EXPECT_EQ(scene.UpdateTransforms(), 1u + 4u + 12u);
+        EXPECT_EQ(scene.UpdateTransforms(), 0u);
+
+        //? one branch and its 3 leaves, the rest of the tree is not visited
+        branches[2].GetComponent<TransformComponent>().SetPosition({5.f, 5.f, 0.f});
+        EXPECT_EQ(scene.UpdateTransforms(), 4u);
+    }
+
+    TEST(Scene, ChildrenFollowAParentRecalculatedEarly)
+    {
+        Scene scene;
+        auto root = MakeNode(scene, {10.f, 0.f, 0.f});
+        auto child = MakeNode(scene, {1.f, 0.f, 0.f});
+        child.SetParent(root);
+        scene.UpdateTransforms();
+
+        //? a layer drawing the parent recalculates it before the scene gets to its queue
+        auto &transform = root.GetComponent<TransformComponent>();
+        transform.SetPosition({20.f, 0.f, 0.f});
+        transform.CalculateTranformationMatrix();
+
+        EXPECT_EQ(scene.UpdateTransforms(), 1u);
+        EXPECT_EQ(WorldPosition(child), glm::vec2(21.f, 0.f));
+    }
+
+    TEST(Scene, DestroyingAParentMovesItsChildrenUp)
+    {
+        Scene scene;
+        auto root = MakeNode(scene, {10.f, 0.f, 0.f});
+        auto middle = MakeNode(scene, {5.f, 0.f, 0.f});
+        auto first = MakeNode(scene, {1.f, 0.f, 0.f});
+        auto second = MakeNode(scene, {2.f, 0.f, 0.f});
+
+        middle.SetParent(root);
+        first.SetParent(middle);
+        second.SetParent(middle);
+        scene.UpdateTransforms();
+
+        scene.GetRegistry().destroy(middle.GetId());
+
+        auto &rootRelation = root.GetComponent<RelationshipComponent>();
+        EXPECT_EQ(rootRelation.ChildrenCount, 2u);
+        EXPECT_EQ(first.GetComponent<RelationshipComponent>().Parent, root.GetId());
+        EXPECT_EQ(second.GetComponent<RelationshipComponent>().Parent, root.GetId());
+        EXPECT_EQ(first.GetComponent<RelationshipComponent>().Depth, 1u);
+
+        for (auto child = rootRelation.FirstChild; child != entt::null; child = scene.GetRegistry().get<RelationshipComponent>(child).NextSibling)
+            EXPECT_TRUE(scene.GetRegistry().valid(child));
+
+        scene.UpdateTransforms();
+        EXPECT_EQ(WorldPosition(first), glm::vec2(11.f, 0.f));
+        EXPECT_EQ(WorldPosition(second), glm::vec2(12.f, 0.f));
+    }
+
+    TEST(Scene, DestroyingASiblingKeepsTheListLinked)
+    {
+        Scene scene;
+        auto root = MakeNode(scene, {0.f, 0.f, 0.f});
+        std::vector<Entity> children;
+
+        for (int i = 0; i < 3; i++)
+        {
+            children.push_back(MakeNode(scene, {float(i), 0.f, 0.f}));
+            children.back().SetParent(root);
+        }
+
+        scene.GetRegistry().destroy(children[1].GetId());
+
+        uint32_t count = 0;
+        auto &registry = scene.GetRegistry();
+        for (auto child = root.GetComponent<RelationshipComponent>().FirstChild; child != entt::null; child = registry.get<RelationshipComponent>(child).NextSibling)
+        {
+            EXPECT_NE(child, children[1].GetId());
+            count++;
+        }
+
+        EXPECT_EQ(count, 2u);
+        EXPECT_EQ(root.GetComponent<RelationshipComponent>().ChildrenCount, 2u);
+    }
+
+    TEST(Scene, DepthIsKnownBeforeTheMatrix)
+    {
+        Scene scene;
+        auto root = MakeNode(scene, {0.f, 0.f, 2.f});
+        auto child = MakeNode(scene, {0.f, 0.f, 0.5f});
+        child.SetParent(root);
+        scene.UpdateTransforms();
+
+        auto &transform = child.GetComponent<TransformComponent>();
+        transform.SetPosition({0.f, 0.f, 1.f});
+        EXPECT_TRUE(transform.IsDirty());
+        EXPECT_FLOAT_EQ(transform.GetDepth(), 3.f); // sorted submission keys on it before the renderer recalculates
+
+        scene.UpdateTransforms();
+        EXPECT_FLOAT_EQ(transform.GetTransformationMatrix()[3][2], 3.f);
+    }
+
+    TEST(Scene, InterleavedSpritesAreSortedForTheFrame)
+    {
+        NullGl::Install();
+        Renderer2D::Init();
+
+        Scene scene;
+        auto texture = MakeRef<SubTexture>(Texture::Create({2, 2}, 4));
+
+        //? a plain sprite between two textured ones, neither group lies in front of the other
+        for (float depth : {0.f, 1.f})
+        {
+            auto sprite = MakeNode(scene, {0.f, 0.f, depth});
+            sprite.AddComponent<SpriteRenderComponent>();
+            sprite.AddComponent<TextureComponent>(texture);
+        }
+        MakeNode(scene, {0.f, 0.f, 0.5f}).AddComponent<SpriteRenderComponent>();
+
+        NullGl::ResetStats();
+        Renderer2D::BeginScene(MakeRef<OrthographicCamera>(-10.f, 10.f, -10.f, 10.f));
+        scene.OnRender();
+        Renderer2D::EndScene();
+
+        EXPECT_EQ(NullGl::GetStats().vertices, 3u * 6u);
+        EXPECT_FALSE(Renderer2D::GetSettings().sortedSubmission); // only for this frame
+    }
+
+} // namespace ant
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "Graphics/SkylinePacker.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        bool Overlaps(const PackedRect &l, const glm::ivec2 &lSize, const PackedRect &r, const glm::ivec2 &rSize, int32_t padding)
+        {
+            //? padded rects, the padding of two images must not overlap either
+            return l.page == r.page &&
+                   l.position.x - padding < r.position.x + rSize.x + padding && r.position.x - padding < l.position.x + lSize.x + padding &&
+                   l.position.y - padding < r.position.y + rSize.y + padding && r.position.y - padding < l.position.y + lSize.y + padding;
+        }
+    }
+
+    TEST(SkylinePacker, FillsAPageExactly)
+    {
+        SkylinePacker packer({64, 64});
+        glm::ivec2 position;
+
+        for (int32_t i = 0; i < 16; i++)
+            ASSERT_TRUE(packer.Insert({16, 16}, position));
+
+        EXPECT_FALSE(packer.Insert({1, 1}, position));
+        EXPECT_EQ(packer.GetUsedArea(), 64u * 64u);
+    }
+
+    TEST(SkylinePacker, PlacesBottomLeftFirst)
+    {
+        SkylinePacker packer({64, 64});
+        glm::ivec2 position;
+
+        ASSERT_TRUE(packer.Insert({32, 16}, position));
+        EXPECT_EQ(position, glm::ivec2(0, 0));
+
+        ASSERT_TRUE(packer.Insert({32, 8}, position));
+        EXPECT_EQ(position, glm::ivec2(32, 0));
+
+        //? the lower segment on the right wins over stacking on the left
+        ASSERT_TRUE(packer.Insert({32, 8}, position));
+        EXPECT_EQ(position, glm::ivec2(32, 8));
+    }
+
+    TEST(PackSkyline, RectsStayInsideThePageAndApart)
+    {
+        std::vector<glm::ivec2> sizes;
+        for (int32_t i = 0; i < 200; i++)
+            sizes.push_back({4 + (i * 7) % 29, 4 + (i * 13) % 31});
+
+        const glm::ivec2 pageSize = {128, 128};
+        const int32_t padding = 2;
+        auto layout = PackSkyline(sizes, pageSize, padding);
+
+        ASSERT_EQ(layout.rects.size(), sizes.size());
+        EXPECT_GT(layout.pageCount, 1u);
+
+        for (size_t i = 0; i < sizes.size(); i++)
+        {
+            auto &rect = layout.rects[i];
+            ASSERT_GE(rect.page, 0);
+            ASSERT_LT(uint32_t(rect.page), layout.pageCount);
+
+            EXPECT_GE(rect.position.x - padding, 0);
+            EXPECT_GE(rect.position.y - padding, 0);
+            EXPECT_LE(rect.position.x + sizes[i].x + padding, pageSize.x);
+            EXPECT_LE(rect.position.y + sizes[i].y + padding, pageSize.y);
+
+            for (size_t j = 0; j < i; j++)
+                EXPECT_FALSE(Overlaps(rect, sizes[i], layout.rects[j], sizes[j], padding)) << "rects " << i << " and " << j;
+        }
+    }
+
+    TEST(PackSkyline, SkipsImagesBiggerThanAPage)
+    {
+        auto layout = PackSkyline({{30, 30}, {63, 10}, {10, 10}}, {64, 64}, 1);
+
+        EXPECT_EQ(layout.rects[0].page, 0);
+        EXPECT_EQ(layout.rects[1].page, -1); // 65 wide with the padding
+        EXPECT_EQ(layout.rects[2].page, 0);
+        EXPECT_EQ(layout.pageCount, 1u);
+    }
+
+    TEST(PackSkyline, EmptyInputMakesNoPages)
+    {
+        auto layout = PackSkyline({}, {64, 64}, 1);
+
+        EXPECT_TRUE(layout.rects.empty());
+        EXPECT_EQ(layout.pageCount, 0u);
+    }
+
+} // namespace ant
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "Graphics/TextureAtlas.hpp"
+#include "Render/NullGl.hpp"
+
+namespace ant
+{
+    namespace
+    {
+        //? textures create gl objects, NullGl stands in for the context
+        Ref<Texture> MakeTexture(const glm::ivec2 &size, uint32_t channels, uchar first)
+        {
+            NullGl::Install();
+
+            size_t bytes = size_t(size.x) * size.y * channels;
+            auto data = (uchar *)malloc(bytes); // released by the texture with stbi_image_free
+            for (size_t i = 0; i < bytes; i++)
+                data[i] = uchar(first + i);
+
+            auto texture = Texture::Create(size, channels);
+            texture->SetData(data, bytes);
+            return texture;
+        }
+
+        const uchar *Texel(const TextureAtlas &atlas, const glm::ivec2 &pageSize, int32_t x, int32_t y)
+        {
+            return &atlas.GetPageData(0)[(size_t(y) * pageSize.x + x) * 4];
+        }
+    }
+
+    TEST(TextureAtlas, ExpandsGreyAndGreyAlphaToRGBA)
+    {
+        const glm::ivec2 pageSize = {32, 32};
+        auto atlas = TextureAtlas::Create(pageSize, 0);
+        auto grey = MakeTexture({3, 2}, 1, 10);
+        auto greyAlpha = MakeTexture({3, 2}, 2, 100);
+
+        atlas->Add(grey);
+        atlas->Add(greyAlpha);
+        atlas->Pack();
+        ASSERT_EQ(atlas->GetPageCount(), 1u);
+
+        //? both are 2 high, the stable order keeps grey at the origin and grey alpha right of it
+        const uchar *g = Texel(*atlas, pageSize, 1, 1);
+        uchar value = 10 + 1 * 3 + 1;
+        EXPECT_EQ(g[0], value);
+        EXPECT_EQ(g[1], value);
+        EXPECT_EQ(g[2], value);
+        EXPECT_EQ(g[3], 0xff);
+
+        const uchar *ga = Texel(*atlas, pageSize, 3 + 2, 0);
+        uchar greyValue = 100 + 2 * 2;
+        EXPECT_EQ(ga[0], greyValue);
+        EXPECT_EQ(ga[1], greyValue);
+        EXPECT_EQ(ga[2], greyValue);
+        EXPECT_EQ(ga[3], uchar(greyValue + 1));
+    }
+
+    TEST(TextureAtlas, PaddingRepeatsTheEdgeTexels)
+    {
+        const glm::ivec2 pageSize = {16, 16};
+        const int32_t padding = 2;
+        auto atlas = TextureAtlas::Create(pageSize, padding);
+        auto texture = MakeTexture({3, 3}, 4, 0);
+
+        atlas->Add(texture);
+        atlas->Pack();
+        ASSERT_EQ(atlas->GetStats().packedCount, 1u);
+
+        //? the image sits at (padding, padding), every padding texel copies the nearest image texel
+        for (int32_t y = 0; y < 3 + 2 * padding; y++)
+        {
+            for (int32_t x = 0; x < 3 + 2 * padding; x++)
+            {
+                int32_t sx = std::clamp(x - padding, 0, 2);
+                int32_t sy = std::clamp(y - padding, 0, 2);
+                const uchar *expected = texture->GetData() + (sy * 3 + sx) * 4;
+
+                EXPECT_EQ(std::memcmp(Texel(*atlas, pageSize, x, y), expected, 4), 0) << "texel " << x << ", " << y;
+            }
+        }
+    }
+
+} // namespace ant
@@ -0,0 +1,13 @@
+#include <gtest/gtest.h>
+#include <spdlog/logger.h>
+#include "Core/Logger.hpp"
+
+//! ctest runs every test in its own process, so a test may install NullGl without affecting the others
+int main(int argc, char **argv)
+{
+    ant::Logger::Init();
+    ant::Logger::GetCoreLogger()->set_level(spdlog::level::warn);
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}